@@ -0,0 +1,190 @@
+/**
+ * @file async_io.h
+ * @brief Asynchronous, batched file I/O for imports, exports and covers
+ *
+ * Large imports and cover scans touch thousands of files. Reading them
+ * one blocking call at a time leaves a fast SSD mostly idle, and a
+ * thread per file does not scale. AsyncIo queues many reads and writes
+ * at once and reports each completion through a callback.
+ *
+ * On Linux it uses io_uring: a batch is one system call, and buffers
+ * can be registered once so the kernel does not map them on every
+ * request. Where io_uring is missing, blocked (seccomp sandboxes) or
+ * lacks the read/write opcodes (kernels before 5.6), and on other
+ * platforms, a small pool of threads runs
+ * pread()/pwrite() instead. Callers see the same behaviour either way.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Direction of a request
+ */
+enum class IoOperation {
+    Read,
+    Write
+};
+
+/**
+ * @brief One read or write of a byte range
+ *
+ * The buffer must stay valid until the callback has run. A read stops
+ * early only at end of file; a write either completes or fails.
+ */
+struct IoRequest {
+    IoOperation operation = IoOperation::Read;
+    int fd = -1; // open file descriptor
+    std::uint64_t offset = 0; // file position
+    void* buffer = nullptr; // data to write or space to read into
+    std::size_t length = 0; // bytes to transfer
+    int bufferIndex = -1; // registered buffer holding `buffer`, or -1
+    std::function<void(std::int64_t result)> onComplete; // bytes transferred, or -errno
+};
+
+/**
+ * @brief Runs a completion callback (for example on a task scheduler)
+ */
+using IoExecutor = std::function<void(std::function<void()> task)>;
+
+/**
+ * @brief Which implementation an AsyncIo uses
+ */
+enum class IoBackend {
+    Auto,       // io_uring when available, else the thread pool
+    ThreadPool  // always the thread pool
+};
+
+/**
+ * @brief A queue of asynchronous file requests
+ *
+ * submit() may be called from any thread. Callbacks run on the I/O
+ * completion thread, or are handed to the executor when one is given;
+ * they must not call drain().
+ */
+class AsyncIo {
+    public:
+        /**
+         * @brief Constructor - sets up the ring or the worker threads
+         *
+         * @param queueDepth Requests in flight at once (more are queued)
+         * @param executor Runs completion callbacks (empty: run them inline)
+         * @param backend Implementation to use
+         */
+        explicit AsyncIo(std::size_t queueDepth = 128, IoExecutor executor = {},
+                         IoBackend backend = IoBackend::Auto);
+
+        /**
+         * @brief Destructor - waits for outstanding requests
+         */
+        ~AsyncIo();
+
+        AsyncIo(const AsyncIo&) = delete;
+        AsyncIo& operator=(const AsyncIo&) = delete;
+
+        /**
+         * @brief Name of the implementation in use ("io_uring" or "threads")
+         */
+        const char* getBackendName() const;
+
+        /**
+         * @brief Register buffers that requests can name by index
+         *
+         * @param buffers (address, size) of each buffer
+         * @return True on success
+         *
+         * Registering pins the buffers once, instead of on every request.
+         * Must be called while no request is in flight. The thread pool
+         * accepts and ignores registrations.
+         */
+        bool registerBuffers(const std::vector<std::pair<void*, std::size_t>>& buffers);
+
+        /**
+         * @brief Queue a batch of requests
+         * @param batch The requests (submitted together where possible)
+         */
+        void submit(std::vector<IoRequest> batch);
+
+        /**
+         * @brief Wait until every submitted request has completed
+         *
+         * Callbacks handed to an executor may still be pending.
+         */
+        void drain();
+
+    private:
+        struct Ring;
+
+        /**
+         * @brief Body of the thread pool workers
+         */
+        void runWorker();
+
+        /**
+         * @brief Body of the io_uring completion thread
+         */
+        void runReaper();
+
+        /**
+         * @brief Run one request with blocking calls (thread pool)
+         * @return Bytes transferred, or -errno
+         */
+        static std::int64_t perform(const IoRequest& request);
+
+        /**
+         * @brief Report a finished request and update the in-flight count
+         */
+        void complete(IoRequest& request, std::int64_t result);
+
+        IoExecutor m_executor; // runs callbacks (may be empty)
+        std::unique_ptr<Ring> m_ring; // io_uring state, null for the thread pool
+        std::mutex m_mutex; // guards the queue, the ring submission side and the counts
+        std::condition_variable m_wake; // new work, or free ring slots
+        std::condition_variable m_idle; // in-flight count reached zero
+        std::deque<IoRequest> m_queue; // requests not handed out yet
+        std::size_t m_outstanding; // submitted but not completed
+        bool m_stopping; // set by the destructor
+        std::vector<std::thread> m_threads; // workers, or the single reaper
+};
+
+// ==== WHOLE-FILE HELPERS ====
+// Both block until their own requests complete, so they must not be
+// called from a thread the queue's executor needs to make progress.
+
+/**
+ * @brief Read several files completely, in parallel
+ *
+ * @param io The queue to use
+ * @param paths Files to read
+ * @return One entry per path: the contents, or empty on error
+ */
+std::vector<std::optional<std::string>> readFiles(AsyncIo& io, const std::vector<std::string>& paths);
+
+/**
+ * @brief Write several files completely, in parallel
+ *
+ * @param io The queue to use
+ * @param files (path, contents) pairs; existing files are truncated
+ * @param sync Flush each file to disk before returning
+ * @return One flag per file: true if it was written completely
+ */
+std::vector<bool> writeFiles(AsyncIo& io,
+                             const std::vector<std::pair<std::string, std::string>>& files,
+                             bool sync = false);
+
+#endif // ASYNC_IO_H
@@ -16,6 +16,9 @@
 #include <chrono> // included because we need to store the date of acquisition, date of start reading, date of finish reading
 #include <optional> // included because we need to store the optional fields like rating, review, etc.
 
+#include "book_fields.h"
+#include "lazy_text.h"
+
 /**
  * @brief Represents a book in the user's personal collection
  *
@@ -48,10 +51,28 @@
          * the basic information available.
         */
         Book (const std::string& title, const std::string& author,
-              const std::string& isbn ==, int pageCount = 0):
+              const std::string& isbn = "", int pageCount = 0);
         
+        /**
+         * @brief Create a partial book holding only some fields of another
+         *
+         * @param source The book to copy from
+         * @param fields The fields to keep (the ID is always kept)
+         * @return A book whose loaded fields are exactly those copied
+         *
+         * Useful to describe a change: Database::updateBook() only writes
+         * the fields a book holds.
+         */
+        static Book partialCopy(const Book& source, BookFieldMask fields);
+
         // ==== GETTERS METHODS ====
 
+        /**
+         * @brief Get the unique identifier of the book
+         * @return The book's ID (0 if not yet saved)
+         */
+        int getId() const;
+
         /**
          * @brief Get the title of the book
          * @return The title of the book
@@ -94,6 +115,24 @@
            */
         const std::optional<std::chrono::system_clock::time_point>& getCompletionDate() const;
 
+        /**
+         * @brief Get the genre of the book
+         * @return The genre (empty if unknown)
+         */
+        const std::string& getGenre() const;
+
+        /**
+         * @brief Get the publisher of the book
+         * @return The publisher (empty if unknown)
+         */
+        const std::string& getPublisher() const;
+
+        /**
+         * @brief Get the publication year of the book
+         * @return The year (0 if unknown)
+         */
+        int getYear() const;
+
           /**
            * @brief Calculate reading progress as a percentage
            * @return Progress percentage (0.0 to 100.0)
@@ -104,6 +143,41 @@
            */
         double getProgressPercentage() const; 
 
+        /**
+         * @brief Get the user's review of the book
+         * @return The review (read from side storage on first get())
+         */
+        const LazyText& getReview() const;
+
+        /**
+         * @brief Get the user's notes on the book
+         * @return The notes (read from side storage on first get())
+         */
+        const LazyText& getNotes() const;
+
+        /**
+         * @brief Get the set of fields that hold real data
+         * @return Mask of BookField bits
+         *
+         * Books loaded with a projection only have the projected fields
+         * populated; every other field keeps its default value. Setting a
+         * field adds it, so Database::updateBook() writes the edit.
+         */
+        BookFieldMask getLoadedFields() const;
+
+        /**
+         * @brief Check whether a field was loaded
+         * @param field The field to check
+         * @return True if the field holds real data
+         */
+        bool hasField(BookField field) const;
+
+        /**
+         * @brief Check whether this book holds every persisted field
+         * @return True if no field was left out by a projection
+         */
+        bool isComplete() const;
+
           // ==== SETTER METHODS ====
 
           /**
@@ -154,6 +228,36 @@
          */
         void setCompletionDate(const std::chrono::system_clock::time_point& completionDate);
 
+        /**
+         * @brief Set the genre of the book
+         * @param genre The new genre (empty if unknown)
+         */
+        void setGenre(const std::string& genre);
+
+        /**
+         * @brief Set the publisher of the book
+         * @param publisher The new publisher (empty if unknown)
+         */
+        void setPublisher(const std::string& publisher);
+
+        /**
+         * @brief Set the publication year of the book
+         * @param year The new year (0 if unknown)
+         */
+        void setYear(int year);
+
+        /**
+         * @brief Set the user's review of the book
+         * @param review The new review (empty to remove it)
+         */
+        void setReview(const std::string& review);
+
+        /**
+         * @brief Set the user's notes on the book
+         * @param notes The new notes (empty to remove them)
+         */
+        void setNotes(const std::string& notes);
+
         // ==== UTILITY METHODS ====
         
         /**
@@ -182,7 +286,33 @@
          */
         void resetProgress();
 
+        /**
+         * @brief Copy some fields from another book
+         *
+         * @param other The book to copy from
+         * @param fields The fields to copy (they become loaded here)
+         *
+         * Values are copied as they are, without validation or setter side
+         * effects. This is meant for restoring stored values (undo, merging
+         * a partial book into a full one), not for user edits.
+         */
+        void copyFieldsFrom(const Book& other, BookFieldMask fields);
+
+        /**
+         * @brief Find the core fields whose values differ from another book
+         * @param other The book to compare with
+         * @return Mask of differing core fields (reviews and notes are not compared)
+         */
+        BookFieldMask getDifferentFields(const Book& other) const;
+
     private:
+        // The database and the in-memory table fill books directly so that
+        // loading does not trigger setter side effects (like stamping a
+        // start date)
+        friend class Database;
+        friend struct BookChunk;
+        friend struct BookSchema;
+
         // ==== MEMBER VARIABLES ====
 
         int m_id; // unique identifier for the book
@@ -193,6 +323,12 @@
         int m_currentPage; // current page that the user is on
         std::optional<std::chrono::system_clock::time_point> m_startDate; // date when the reading was started
         std::optional<std::chrono::system_clock::time_point> m_completionDate; // date when the reading was completed
+        std::string m_genre; // genre of the book (empty if unknown)
+        std::string m_publisher; // publisher of the book (empty if unknown)
+        int m_year; // publication year (0 if unknown)
+        LazyText m_review; // user's review, kept out of the books row
+        LazyText m_notes; // user's notes, kept out of the books row
+        BookFieldMask m_loadedFields; // which of the fields above hold real data
 };
 
 #endif // BOOK_H
\ No newline at end of file
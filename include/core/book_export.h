@@ -0,0 +1,44 @@
+/**
+ * @file book_export.h
+ * @brief CSV and JSON export of Book objects
+ *
+ * The writers are generated from BookSchema, so a new core field shows
+ * up in exports without touching this code.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef BOOK_EXPORT_H
+#define BOOK_EXPORT_H
+
+#include "book.h"
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Write books as CSV (RFC 4180) with a header row
+ *
+ * @param out Stream to write to
+ * @param books The books to write
+ * @param fields Columns to write, in schema column order
+ *
+ * Dates are written as UTC ISO 8601 ("2025-10-12T08:30:00Z") and are
+ * empty when not set. Fields a partial book did not load are empty.
+ */
+void writeBooksCsv(std::ostream& out, const std::vector<Book>& books,
+                   BookFieldMask fields = kCoreBookFields);
+
+/**
+ * @brief Write books as a JSON array of objects
+ *
+ * @param out Stream to write to
+ * @param books The books to write
+ * @param fields Keys to write (fields a book did not load are left out)
+ *
+ * Dates are UTC ISO 8601 strings, or null when not set.
+ */
+void writeBooksJson(std::ostream& out, const std::vector<Book>& books,
+                    BookFieldMask fields = kCoreBookFields);
+
+#endif // BOOK_EXPORT_H
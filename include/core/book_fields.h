@@ -0,0 +1,73 @@
+/**
+ * @file book_fields.h
+ * @brief Field identifiers and projections for Book objects
+ *
+ * Each persisted Book field gets one bit. A set of bits (a "projection")
+ * tells the Database which columns to read, and tells the caller which
+ * fields of a loaded Book actually hold data.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef BOOK_FIELDS_H
+#define BOOK_FIELDS_H
+
+#include <cstdint> // included because we need fixed width integers for the bit mask
+
+/**
+ * @brief One bit per persisted Book field
+ */
+enum class BookField : std::uint32_t {
+    Id             = 1u << 0,
+    Title          = 1u << 1,
+    Author         = 1u << 2,
+    Isbn           = 1u << 3,
+    PageCount      = 1u << 4,
+    CurrentPage    = 1u << 5,
+    StartDate      = 1u << 6,
+    CompletionDate = 1u << 7,
+    Genre          = 1u << 8,
+    Publisher      = 1u << 9,
+    Year           = 1u << 10,
+    Review         = 1u << 11, // stored in side storage, loaded lazily
+    Notes          = 1u << 12  // stored in side storage, loaded lazily
+};
+
+/**
+ * @brief A set of BookField bits
+ */
+using BookFieldMask = std::uint32_t;
+
+/**
+ * @brief Convert a single field to its mask bit
+ */
+constexpr BookFieldMask toMask(BookField field) {
+    return static_cast<BookFieldMask>(field);
+}
+
+constexpr BookFieldMask operator|(BookField lhs, BookField rhs) {
+    return toMask(lhs) | toMask(rhs);
+}
+
+constexpr BookFieldMask operator|(BookFieldMask lhs, BookField rhs) {
+    return lhs | toMask(rhs);
+}
+
+// ==== COMMON PROJECTIONS ====
+
+/// Fields stored as columns of the books table
+constexpr BookFieldMask kCoreBookFields = 0x7FFu;
+
+/// Long text fields stored in side storage (see LazyText)
+constexpr BookFieldMask kTextBookFields = BookField::Review | BookField::Notes;
+
+/// Every persisted field (what a fully constructed Book holds)
+constexpr BookFieldMask kAllBookFields = kCoreBookFields | kTextBookFields;
+
+/// What a list view needs: title, author and enough to compute progress
+constexpr BookFieldMask kListViewFields =
+    BookField::Id | BookField::Title | BookField::Author |
+    BookField::PageCount | BookField::CurrentPage;
+
+#endif // BOOK_FIELDS_H
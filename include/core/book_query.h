@@ -0,0 +1,179 @@
+/**
+ * @file book_query.h
+ * @brief Filter queries over the in-memory book table
+ *
+ * A BookFilter describes which books to keep. Building a BookQuery from
+ * it "compiles" the filter: the numeric predicates that are set pick one
+ * instantiation of a fused scan loop (one per combination of active
+ * predicates), which tests all of them per row without branches and
+ * writes the passing rows to a selection vector. Genre, publisher and
+ * year predicates are evaluated once per dictionary value and then
+ * filter the selection by code; the author compare only runs on the
+ * rows that are left.
+ * Chunks are scanned in parallel, and chunks whose zone maps rule out
+ * a range predicate are skipped without reading their columns.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef BOOK_QUERY_H
+#define BOOK_QUERY_H
+
+#include "book.h"
+#include "book_table.h"
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+
+/**
+ * @brief Inclusive range of page numbers
+ */
+struct PageRange {
+    int min = INT_MIN;
+    int max = INT_MAX;
+};
+
+/**
+ * @brief Inclusive range of dates; books without the date never match
+ */
+struct DateRange {
+    std::chrono::system_clock::time_point from = std::chrono::system_clock::time_point::min();
+    std::chrono::system_clock::time_point to = std::chrono::system_clock::time_point::max();
+};
+
+/**
+ * @brief Inclusive range of publication years
+ */
+struct YearRange {
+    int min = INT_MIN;
+    int max = INT_MAX;
+};
+
+/**
+ * @brief Which books a query keeps (every set predicate must hold)
+ */
+struct BookFilter {
+    ReadingState state = ReadingState::Any;
+    std::optional<PageRange> pageCount;
+    std::optional<PageRange> currentPage;
+    std::optional<DateRange> startDate;
+    std::optional<DateRange> completionDate;
+    std::optional<std::string> author; // exact match
+    std::optional<std::string> genre; // exact match
+    std::optional<std::string> publisher; // exact match
+    std::optional<YearRange> year; // books with an unknown year (0) only match ranges containing 0
+};
+
+/**
+ * @brief The rows of one chunk that matched a query
+ */
+struct ChunkSelection {
+    std::uint32_t chunk; // chunk index in the snapshot
+    std::vector<std::uint32_t> rows; // matching rows, ascending
+};
+
+/**
+ * @brief A compiled filter, reusable across snapshots and threads
+ */
+class BookQuery {
+    public:
+        /**
+         * @brief Constructor - compiles a filter
+         * @param filter The predicates
+         */
+        explicit BookQuery(const BookFilter& filter);
+
+        /**
+         * @brief Get the filter this query was compiled from
+         */
+        const BookFilter& getFilter() const;
+
+        /**
+         * @brief Find the matching rows of a snapshot
+         *
+         * @param snapshot The snapshot to scan
+         * @return One selection per chunk that has matches, in chunk order
+         */
+        std::vector<ChunkSelection> select(const BookTableSnapshot& snapshot) const;
+
+        /**
+         * @brief Find the matching rows of a snapshot as a flat list
+         * @param snapshot The snapshot to scan
+         * @return Matching rows in table order
+         */
+        std::vector<SnapshotRow> selectRows(const BookTableSnapshot& snapshot) const;
+
+        /**
+         * @brief Count the matching books of a snapshot
+         * @param snapshot The snapshot to scan
+         * @return Number of matches
+         */
+        std::size_t count(const BookTableSnapshot& snapshot) const;
+
+        /**
+         * @brief Build the matching books of a snapshot
+         * @param snapshot The snapshot to scan
+         * @return The books, with all core fields, in table order
+         */
+        std::vector<Book> fetch(const BookTableSnapshot& snapshot) const;
+
+        /**
+         * @brief Check one book against the filter
+         * @param book The book (needs all core fields)
+         * @return True if the query would select it
+         */
+        bool matches(const Book& book) const;
+
+        // ==== COMPILED FORM ====
+
+        /**
+         * @brief Predicate bounds in column form (dates in seconds)
+         */
+        struct Bounds {
+            ReadingState state;
+            int pageMin, pageMax;
+            int currentMin, currentMax;
+            std::int64_t startMin, startMax;
+            std::int64_t completionMin, completionMax;
+        };
+
+        /// A fused scan loop: writes matching rows of a chunk, returns the count
+        using Kernel = std::size_t (*)(const BookChunk& chunk, const Bounds& bounds,
+                                       std::uint32_t* rows);
+
+    private:
+        /**
+         * @brief Check a chunk's zone maps against the range predicates
+         * @return False if no row of the chunk can match
+         */
+        bool mayMatch(const BookChunk& chunk) const;
+
+        /**
+         * @brief Flag the dictionary codes of a chunk that pass the filter
+         *
+         * @param chunk The chunk
+         * @param genres, publishers, years Set to one flag per code of
+         *        each dictionary column (left empty when not filtered)
+         * @return False if some predicate matches no value of the chunk
+         */
+        bool matchDictionaries(const BookChunk& chunk, std::vector<std::uint8_t>& genres,
+                               std::vector<std::uint8_t>& publishers,
+                               std::vector<std::uint8_t>& years) const;
+
+        /**
+         * @brief Run the compiled predicates over one chunk
+         * @return Number of matching rows written to rows
+         */
+        std::size_t filterChunk(const BookChunk& chunk, std::uint32_t* rows) const;
+
+        BookFilter m_filter; // the source filter
+        Bounds m_bounds; // the numeric predicates in column form
+        Kernel m_kernel; // fused loop for the active numeric predicates
+};
+
+#endif // BOOK_QUERY_H
@@ -0,0 +1,291 @@
+/**
+ * @file book_schema.h
+ * @brief Compile-time description of the persisted Book fields
+ *
+ * The list of Book columns used to be repeated in the SQL schema, the
+ * statement binders, the row readers and the field masks. BookSchema
+ * describes every core field once (name, SQL type, column index, mask
+ * bit, member and validator) and everything else is generated from it
+ * with fold expressions, so there is no runtime dispatch and no mapping
+ * that can drift out of sync.
+ *
+ * Adding a core field means adding a member to Book, a bit to BookField
+ * and one descriptor below. The static_asserts at the end catch the
+ * rest.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef BOOK_SCHEMA_H
+#define BOOK_SCHEMA_H
+
+#include "book.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+/**
+ * @brief The static field table of Book
+ *
+ * A friend of Book, so the descriptors can point at its members.
+ */
+struct BookSchema {
+    using Date = std::optional<std::chrono::system_clock::time_point>;
+
+    /**
+     * @brief Common part of every field descriptor
+     *
+     * @tparam Field The mask bit of the field
+     * @tparam T The C++ type of the member
+     * @tparam Member Pointer to the Book member
+     */
+    template <BookField Field, typename T, T Book::*Member>
+    struct FieldBase {
+        using ValueType = T;
+        static constexpr BookField field = Field;
+        static constexpr BookFieldMask bit = toMask(Field);
+
+        static const T& get(const Book& book) { return book.*Member; }
+        static T& get(Book& book) { return book.*Member; }
+
+        /// Most fields accept any value; descriptors override this
+        static bool isValid(const T&) { return true; }
+    };
+
+    // ==== FIELD DESCRIPTORS (in column order) ====
+
+    struct IdField : FieldBase<BookField::Id, int, &Book::m_id> {
+        static constexpr const char* name = "id";
+        static constexpr const char* sqlDefinition = "INTEGER PRIMARY KEY AUTOINCREMENT";
+        static constexpr const char* error = "ID cannot be negative";
+        static bool isValid(int value) { return value >= 0; }
+    };
+
+    struct TitleField : FieldBase<BookField::Title, std::string, &Book::m_title> {
+        static constexpr const char* name = "title";
+        static constexpr const char* sqlDefinition = "TEXT NOT NULL";
+        static constexpr const char* error = "Title cannot be empty";
+        static bool isValid(const std::string& value) { return !value.empty(); }
+    };
+
+    struct AuthorField : FieldBase<BookField::Author, std::string, &Book::m_author> {
+        static constexpr const char* name = "author";
+        static constexpr const char* sqlDefinition = "TEXT NOT NULL";
+        static constexpr const char* error = "Author cannot be empty";
+        static bool isValid(const std::string& value) { return !value.empty(); }
+    };
+
+    struct IsbnField : FieldBase<BookField::Isbn, std::string, &Book::m_isbn> {
+        static constexpr const char* name = "isbn";
+        static constexpr const char* sqlDefinition = "TEXT NOT NULL DEFAULT ''";
+        static constexpr const char* error = "ISBN must be 13 digits";
+        static bool isValid(const std::string& value) { return value.empty() || value.length() == 13; }
+    };
+
+    struct PageCountField : FieldBase<BookField::PageCount, int, &Book::m_pageCount> {
+        static constexpr const char* name = "page_count";
+        static constexpr const char* sqlDefinition = "INTEGER NOT NULL DEFAULT 0";
+        static constexpr const char* error = "Page count cannot be negative";
+        static bool isValid(int value) { return value >= 0; }
+    };
+
+    struct CurrentPageField : FieldBase<BookField::CurrentPage, int, &Book::m_currentPage> {
+        static constexpr const char* name = "current_page";
+        static constexpr const char* sqlDefinition = "INTEGER NOT NULL DEFAULT 0";
+        static constexpr const char* error = "Current page cannot be negative";
+        static bool isValid(int value) { return value >= 0; }
+    };
+
+    struct StartDateField : FieldBase<BookField::StartDate, Date, &Book::m_startDate> {
+        static constexpr const char* name = "start_date";
+        static constexpr const char* sqlDefinition = "INTEGER";
+        static constexpr const char* error = "";
+    };
+
+    struct CompletionDateField : FieldBase<BookField::CompletionDate, Date, &Book::m_completionDate> {
+        static constexpr const char* name = "completion_date";
+        static constexpr const char* sqlDefinition = "INTEGER";
+        static constexpr const char* error = "";
+    };
+
+    struct GenreField : FieldBase<BookField::Genre, std::string, &Book::m_genre> {
+        static constexpr const char* name = "genre";
+        static constexpr const char* sqlDefinition = "TEXT NOT NULL DEFAULT ''";
+        static constexpr const char* error = "";
+    };
+
+    struct PublisherField : FieldBase<BookField::Publisher, std::string, &Book::m_publisher> {
+        static constexpr const char* name = "publisher";
+        static constexpr const char* sqlDefinition = "TEXT NOT NULL DEFAULT ''";
+        static constexpr const char* error = "";
+    };
+
+    struct YearField : FieldBase<BookField::Year, int, &Book::m_year> {
+        static constexpr const char* name = "year";
+        static constexpr const char* sqlDefinition = "INTEGER NOT NULL DEFAULT 0";
+        static constexpr const char* error = "Year cannot be negative";
+        static bool isValid(int value) { return value >= 0; }
+    };
+
+    /**
+     * @brief A list of field descriptors with fold-expression helpers
+     */
+    template <typename... Fields>
+    struct FieldList {
+        static constexpr std::size_t count = sizeof...(Fields);
+        static constexpr BookFieldMask mask = (Fields::bit | ... | 0u);
+
+        /**
+         * @brief Call visitor(Descriptor{}) for every field, in column order
+         */
+        template <typename Visitor>
+        static void forEach(Visitor&& visitor) {
+            (visitor(Fields{}), ...);
+        }
+
+        /**
+         * @brief Check that field i uses bit i (so bit order is column order)
+         */
+        static constexpr bool bitsMatchColumns() {
+            std::size_t index = 0;
+            bool ok = true;
+            ((ok = ok && Fields::bit == (1u << index++)), ...);
+            return ok;
+        }
+    };
+
+    /// Every core field, in column order
+    using Fields = FieldList<IdField, TitleField, AuthorField, IsbnField,
+                             PageCountField, CurrentPageField,
+                             StartDateField, CompletionDateField,
+                             GenreField, PublisherField, YearField>;
+
+    // ==== GENERATED OPERATIONS ====
+
+    /**
+     * @brief Generate the CREATE TABLE statement for the core columns
+     * @param table Name of the table
+     */
+    static std::string createTableSql(const std::string& table) {
+        std::string sql = "CREATE TABLE IF NOT EXISTS " + table + " (";
+        bool first = true;
+        Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            sql += first ? " " : ", ";
+            sql += F::name;
+            sql += " ";
+            sql += F::sqlDefinition;
+            first = false;
+        });
+        return sql + ");";
+    }
+
+    /**
+     * @brief Generate ALTER TABLE statements for columns a table lacks
+     *
+     * @param table Name of the table
+     * @param existing Names of the columns the table already has
+     *
+     * Lets databases created by older versions gain new fields. Added
+     * columns must have a default (or allow NULL).
+     */
+    static std::string addMissingColumnsSql(const std::string& table,
+                                            const std::vector<std::string>& existing) {
+        std::string sql;
+        Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            if (std::find(existing.begin(), existing.end(), F::name) == existing.end()) {
+                sql += "ALTER TABLE " + table + " ADD COLUMN " + F::name + " " +
+                       F::sqlDefinition + ";";
+            }
+        });
+        return sql;
+    }
+
+    /**
+     * @brief Comma separated names of the fields in a mask, in column order
+     */
+    static std::string columnList(BookFieldMask fields) {
+        std::string columns;
+        Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            if (fields & F::bit) {
+                columns += columns.empty() ? "" : ", ";
+                columns += F::name;
+            }
+        });
+        return columns;
+    }
+
+    /**
+     * @brief Copy the fields in a mask from one book to another
+     */
+    static void copyFields(Book& target, const Book& source, BookFieldMask fields) {
+        Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            if (fields & F::bit) {
+                F::get(target) = F::get(source);
+            }
+        });
+    }
+
+    /**
+     * @brief Mask of the core fields whose values differ (the dirty bits)
+     */
+    static BookFieldMask differentFields(const Book& lhs, const Book& rhs) {
+        BookFieldMask fields = 0;
+        Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            if (!(F::get(lhs) == F::get(rhs))) {
+                fields |= F::bit;
+            }
+        });
+        return fields;
+    }
+
+    /**
+     * @brief Check the fields in a mask against their validators
+     *
+     * @return Error message of the first invalid field, or nullptr
+     *
+     * Only single-field rules live here. Rules that relate two fields
+     * (current page vs. page count) stay in the Book setters.
+     */
+    static const char* validate(const Book& book, BookFieldMask fields) {
+        const char* error = nullptr;
+        Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            if (!error && (fields & F::bit) && !F::isValid(F::get(book))) {
+                error = F::error;
+            }
+        });
+        return error;
+    }
+
+    /**
+     * @brief Check one value against its field's validator
+     *
+     * @throws std::invalid_argument with the field's error if it is invalid
+     *
+     * Used by the Book setters, so they share the rules and messages of
+     * validate().
+     */
+    template <typename F>
+    static void require(const typename F::ValueType& value) {
+        if (!F::isValid(value)) {
+            throw std::invalid_argument(F::error);
+        }
+    }
+};
+
+// ==== COMPILE-TIME CHECKS ====
+
+static_assert(BookSchema::Fields::mask == kCoreBookFields,
+              "BookSchema must describe exactly the core BookField bits");
+static_assert(BookSchema::Fields::bitsMatchColumns(),
+              "BookSchema fields must be listed in BookField bit order");
+
+#endif // BOOK_SCHEMA_H
@@ -0,0 +1,417 @@
+/**
+ * @file book_table.h
+ * @brief In-memory, versioned table of the book collection
+ *
+ * The BookTable keeps the whole collection in memory in a column layout
+ * split into fixed size chunks. Readers (analytics, the GUI) take an
+ * immutable snapshot and can scan it for as long as they like while
+ * writers keep applying progress updates.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef BOOK_TABLE_H
+#define BOOK_TABLE_H
+
+#include "book.h"
+#include "dictionary_column.h"
+#include "memory_budget.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+/// Maximum number of books stored in one chunk
+constexpr std::size_t kBookChunkCapacity = 4096;
+
+/// Value stored in a date column when the date is not set
+constexpr std::int64_t kNoDate = std::numeric_limits<std::int64_t>::min();
+
+class SortKeyGenerator;
+
+/**
+ * @brief Reading state of a book, as used by filters and rankings
+ */
+enum class ReadingState {
+    Any,
+    NotStarted,  // Current page 0 and not completed
+    InProgress,  // Current page > 0 and not completed
+    Completed    // Last page reached or completion date set
+};
+
+/**
+ * @brief Check a row's columns against a reading state
+ *
+ * Mirrors Book::isCompleted(), in column form so scans can use it.
+ */
+inline bool isInState(ReadingState state, int pageCount, int currentPage,
+                      std::int64_t completionDate) {
+    const bool completed = (pageCount > 0 && currentPage == pageCount) || completionDate != kNoDate;
+    const bool started = currentPage > 0;
+    switch (state) {
+        case ReadingState::NotStarted: return !started && !completed;
+        case ReadingState::InProgress: return started && !completed;
+        case ReadingState::Completed:  return completed;
+        case ReadingState::Any:        break;
+    }
+    return true;
+}
+
+/**
+ * @brief Position of a book inside a snapshot
+ */
+struct SnapshotRow {
+    std::uint32_t chunk;
+    std::uint32_t row;
+};
+
+/**
+ * @brief Minimum and maximum of one column within a chunk
+ *
+ * Scans check a zone map before touching the column: if the wanted
+ * range does not overlap [min, max], no row of the chunk can match.
+ * Bounds may be wider than the data after updates (never narrower),
+ * which keeps skipping safe.
+ */
+struct ZoneMap {
+    std::int64_t min = std::numeric_limits<std::int64_t>::max();
+    std::int64_t max = std::numeric_limits<std::int64_t>::min();
+
+    /**
+     * @brief Widen the bounds to include a value
+     */
+    void add(std::int64_t value) {
+        min = value < min ? value : min;
+        max = value > max ? value : max;
+    }
+
+    /**
+     * @brief Check whether any value could fall in [low, high]
+     */
+    bool overlaps(std::int64_t low, std::int64_t high) const {
+        return min <= high && max >= low;
+    }
+};
+
+/**
+ * @brief Up to kBookChunkCapacity books stored column by column
+ *
+ * Dates are stored as seconds since the epoch (kNoDate when unset) so
+ * that scans over them are plain integer loops. When the chunk has a
+ * SortKeyGenerator, titleKeys and authorKeys hold the collated sort keys
+ * of every row; otherwise they are empty.
+ *
+ * Each numeric column has a zone map. Date zone maps only cover rows
+ * where the date is set. Genre, publisher and year have few distinct
+ * values and are dictionary encoded (run-length encoded once sealed,
+ * when their values come in runs).
+ *
+ * A chunk is only modified while a writer builds it. Once it is part of
+ * a published snapshot it never changes again. Its heap memory is
+ * charged to the BookTable subsystem (key columns to SortKeys) for as
+ * long as any snapshot holds it.
+ */
+struct BookChunk {
+    std::vector<int> ids;
+    std::vector<std::string> titles;
+    std::vector<std::string> authors;
+    std::vector<std::string> isbns;
+    std::vector<int> pageCounts;
+    std::vector<int> currentPages;
+    std::vector<std::int64_t> startDates;
+    std::vector<std::int64_t> completionDates;
+    DictionaryColumn<std::string> genres;
+    DictionaryColumn<std::string> publishers;
+    DictionaryColumn<int> years;
+    std::vector<std::string> titleKeys;
+    std::vector<std::string> authorKeys;
+    std::shared_ptr<const SortKeyGenerator> sortKeys; // locale of the key columns (may be null)
+
+    ZoneMap pageCountZone;
+    ZoneMap currentPageZone;
+    ZoneMap startDateZone;
+    ZoneMap completionDateZone;
+
+    MemoryCharge tableMemory{ MemorySubsystem::BookTable };
+    MemoryCharge keyMemory{ MemorySubsystem::SortKeys };
+
+    /**
+     * @brief Number of books in the chunk
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Build a Book object from one row
+     * @param row Row index (must be < size())
+     * @return The book with all core fields loaded
+     */
+    Book getBook(std::size_t row) const;
+
+    /**
+     * @brief Append a book as a new row
+     * @param book The book to append
+     */
+    void append(const Book& book);
+
+    /**
+     * @brief Overwrite one row with a book
+     * @param row Row index (must be < size())
+     * @param book The new values
+     */
+    void assign(std::size_t row, const Book& book);
+
+    /**
+     * @brief Move the last row into a row, then drop the last row
+     * @param row Row index to remove (must be < size())
+     */
+    void swapRemove(std::size_t row);
+
+    /**
+     * @brief Recompute the zone maps exactly from the columns
+     *
+     * append() and assign() only ever widen the zone maps.
+     */
+    void refreshZones();
+
+    /**
+     * @brief Prepare a chunk for publishing
+     *
+     * Refreshes the zone maps and picks the encoding of the dictionary
+     * columns. Writers call this on chunks they built or changed.
+     */
+    void seal();
+
+    /**
+     * @brief Recompute the memory charges from the column sizes
+     */
+    void updateMemoryCharges();
+
+    /**
+     * @brief Widen the zone maps to include one row
+     * @param row Row index (must be < size())
+     */
+    void widenZones(std::size_t row);
+
+    /**
+     * @brief Regenerate the sort key columns for another locale
+     * @param generator The new generator (null drops the key columns)
+     */
+    void rebuildSortKeys(std::shared_ptr<const SortKeyGenerator> generator);
+};
+
+/**
+ * @brief An immutable, consistent view of the whole table
+ *
+ * Snapshots share unchanged chunks with each other, so holding on to an
+ * old snapshot only costs the chunks that changed since.
+ */
+class BookTableSnapshot {
+    public:
+        /**
+         * @brief Constructor - wraps a list of published chunks
+         * @param chunks The chunks (never modified afterwards)
+         * @param version Version number of this snapshot
+         */
+        BookTableSnapshot(std::vector<std::shared_ptr<const BookChunk>> chunks,
+                          std::uint64_t version);
+
+        /**
+         * @brief Total number of books
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Number of chunks
+         */
+        std::size_t getChunkCount() const;
+
+        /**
+         * @brief Access one chunk
+         * @param index Chunk index (must be < getChunkCount())
+         */
+        const BookChunk& getChunk(std::size_t index) const;
+
+        /**
+         * @brief Get the shared pointer to one chunk
+         * @param index Chunk index (must be < getChunkCount())
+         */
+        const std::shared_ptr<const BookChunk>& getChunkPointer(std::size_t index) const;
+
+        /**
+         * @brief Version number (increases with every published change)
+         */
+        std::uint64_t getVersion() const;
+
+        /**
+         * @brief Build every book in the snapshot
+         * @return All books, chunk by chunk
+         */
+        std::vector<Book> toBooks() const;
+
+    private:
+        std::vector<std::shared_ptr<const BookChunk>> m_chunks; // published chunks
+        std::uint64_t m_version; // version number of this snapshot
+        std::size_t m_size; // total number of rows
+};
+
+/**
+ * @brief The versioned in-memory book table
+ *
+ * Readers call snapshot() and get a consistent view that never changes
+ * under them. They never wait for writers: a writer copies only the
+ * chunks it touches, builds a new snapshot on the side and then swaps
+ * the current pointer in one atomic step (RCU style). Old snapshots are
+ * freed when the last reader drops them.
+ *
+ * Writers are serialized against each other with a mutex.
+ *
+ * When the SortKeys subsystem goes over its memory budget, the table
+ * drops its sort key columns: collated orders then fall back to byte
+ * order until a generator is set again (the database keeps its keys).
+ */
+class BookTable {
+    public:
+        /**
+         * @brief Constructor - creates an empty table
+         */
+        BookTable();
+
+        /**
+         * @brief Destructor - unregisters the memory reclaimer
+         */
+        ~BookTable();
+
+        BookTable(const BookTable&) = delete;
+        BookTable& operator=(const BookTable&) = delete;
+
+        // ==== READING ====
+
+        /**
+         * @brief Get the current version of the table
+         * @return An immutable snapshot (never null)
+         */
+        std::shared_ptr<const BookTableSnapshot> snapshot() const;
+
+        /**
+         * @brief Find a book in the current version
+         * @param id The ID of the book
+         * @return The book, or empty if it is not in the table
+         */
+        std::optional<Book> findBook(int id) const;
+
+        // ==== WRITING ====
+
+        /**
+         * @brief Replace the whole table
+         * @param books The books to store (need all core fields)
+         */
+        void load(const std::vector<Book>& books);
+
+        /**
+         * @brief Insert or update books and remove others in one version
+         *
+         * @param changed Books to insert or overwrite (matched by ID)
+         * @param removed IDs of books to remove
+         * @return The newly published snapshot
+         *
+         * Each touched chunk is copied once no matter how many of its
+         * rows change, and readers see either none or all of the changes.
+         */
+        std::shared_ptr<const BookTableSnapshot> apply(const std::vector<Book>& changed,
+                                                       const std::vector<int>& removed = {});
+
+        /**
+         * @brief Overwrite only the loaded fields of existing books
+         *
+         * @param partial Books carrying the fields to write (matched by
+         *        ID); books no longer in the table are skipped
+         * @return The newly published snapshot
+         *
+         * Fields are merged into the current rows under the writer lock,
+         * so updates published since the caller read the table are kept.
+         */
+        std::shared_ptr<const BookTableSnapshot> merge(const std::vector<Book>& partial);
+
+        /**
+         * @brief Insert or update a single book
+         * @param book The book (matched by ID)
+         */
+        void upsert(const Book& book);
+
+        /**
+         * @brief Remove a single book
+         * @param id The ID of the book
+         * @return True if the book was in the table
+         */
+        bool remove(int id);
+
+        /**
+         * @brief Publish a snapshot built elsewhere (for example by undo)
+         *
+         * @param snapshot The snapshot to make current
+         * @return The published snapshot (with a new version number)
+         */
+        std::shared_ptr<const BookTableSnapshot> restore(const BookTableSnapshot& snapshot);
+
+        // ==== SORT KEYS ====
+
+        /**
+         * @brief Switch the locale of the sort key columns
+         *
+         * @param generator Generator for the new locale (null for none)
+         * @return The newly published snapshot
+         *
+         * Keys are generated once here for every row; later writes keep
+         * them up to date.
+         */
+        std::shared_ptr<const BookTableSnapshot> setSortKeyGenerator(
+            std::shared_ptr<const SortKeyGenerator> generator);
+
+        /**
+         * @brief Get the generator used for the sort key columns
+         * @return The generator, or null if keys are not maintained
+         */
+        std::shared_ptr<const SortKeyGenerator> getSortKeyGenerator() const;
+
+    private:
+        /**
+         * @brief Where a book lives inside the current snapshot
+         */
+        struct Location {
+            std::size_t chunk;
+            std::size_t row;
+        };
+
+        /**
+         * @brief Rebuild the ID index from a list of chunks
+         */
+        void rebuildIndex(const std::vector<std::shared_ptr<const BookChunk>>& chunks);
+
+        /**
+         * @brief Shared body of apply() and merge()
+         */
+        std::shared_ptr<const BookTableSnapshot> write(const std::vector<Book>& changed,
+                                                       const std::vector<int>& removed,
+                                                       bool mergeFields);
+
+        /**
+         * @brief Swap in a new snapshot built from the given chunks
+         */
+        std::shared_ptr<const BookTableSnapshot> publish(
+            std::vector<std::shared_ptr<const BookChunk>> chunks);
+
+        std::shared_ptr<const BookTableSnapshot> m_current; // accessed only atomically
+        mutable std::mutex m_writeMutex; // serializes writers (and index lookups)
+        std::unordered_map<int, Location> m_index; // book ID -> location (writers only)
+        std::uint64_t m_nextVersion; // version of the next published snapshot
+        std::shared_ptr<const SortKeyGenerator> m_sortKeys; // locale of new chunks (writers only)
+        int m_memoryReclaimer; // handle of the SortKeys reclaimer
+};
+
+#endif // BOOK_TABLE_H
@@ -0,0 +1,125 @@
+/**
+ * @file book_top_k.h
+ * @brief Top-K queries over the in-memory book table for dashboards
+ *
+ * Dashboards show short ranked lists ("10 longest books in progress",
+ * "recently completed"). Sorting the whole collection for that is
+ * wasteful: topBooks() keeps a K-sized heap per worker, skips every row
+ * that cannot beat the current K-th best with a branch-free threshold
+ * pass, and scans the chunks in parallel.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef BOOK_TOP_K_H
+#define BOOK_TOP_K_H
+
+#include "book.h"
+#include "book_table.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief The value books are ranked by
+ */
+enum class TopKMetric {
+    PageCount,      // Longest books
+    CurrentPage,    // Furthest read
+    PagesLeft,      // Page count minus current page
+    StartDate,      // Books without a start date are not ranked
+    CompletionDate  // Books without a completion date are not ranked
+};
+
+/**
+ * @brief A top-K request
+ */
+struct TopKQuery {
+    TopKMetric metric = TopKMetric::PageCount;
+    ReadingState state = ReadingState::Any; // which books take part
+    std::size_t k = 10;
+    bool largest = true; // False ranks the smallest values first
+};
+
+/**
+ * @brief One ranked book
+ */
+struct TopKEntry {
+    std::int64_t score; // value of the metric (seconds since the epoch for dates)
+    Book book; // the book, with all core fields
+};
+
+/**
+ * @brief Find the best K books of a snapshot
+ *
+ * @param snapshot The snapshot to scan
+ * @param query What to rank and how many
+ * @return Up to query.k entries, best first; ties go to the lower ID
+ */
+std::vector<TopKEntry> topBooks(const BookTableSnapshot& snapshot, const TopKQuery& query);
+
+/**
+ * @brief Score of a book for a query
+ *
+ * @param book The book (needs all core fields)
+ * @param query The query
+ * @param score Set to the metric value if the book takes part
+ * @return False if the book is filtered out by the query
+ */
+bool scoreBook(const Book& book, const TopKQuery& query, std::int64_t& score);
+
+/**
+ * @brief A top-K result kept up to date as books change
+ *
+ * Most progress updates can be folded into the current result without
+ * a scan: a book that enters the top K, or moves up inside it, only
+ * reorders the list. Only when a ranked book drops down or leaves (and
+ * a book outside the list might now belong in it) is the result marked
+ * stale, and the next refresh() rescans the table.
+ */
+class TopKTracker {
+    public:
+        /**
+         * @brief Constructor - tracks one query
+         * @param query The query to keep answered
+         */
+        explicit TopKTracker(const TopKQuery& query);
+
+        /**
+         * @brief Get the current result, rescanning only if it is stale
+         * @param snapshot The current table snapshot
+         * @return Up to k entries, best first
+         */
+        const std::vector<TopKEntry>& refresh(const BookTableSnapshot& snapshot);
+
+        /**
+         * @brief Fold changes that were applied to the table into the result
+         *
+         * @param changed Books that were inserted or updated (all core fields)
+         * @param removed IDs of books that were removed
+         */
+        void onBooksChanged(const std::vector<Book>& changed, const std::vector<int>& removed = {});
+
+        /**
+         * @brief Check whether the next refresh() has to rescan
+         */
+        bool isStale() const;
+
+        /**
+         * @brief Get the tracked query
+         */
+        const TopKQuery& getQuery() const;
+
+    private:
+        /**
+         * @brief Apply one changed book; false if a rescan is needed
+         */
+        bool applyChange(const Book& book);
+
+        TopKQuery m_query; // the tracked query
+        std::vector<TopKEntry> m_entries; // current result, best first
+        bool m_stale; // true until the first scan and after unfoldable changes
+};
+
+#endif // BOOK_TOP_K_H
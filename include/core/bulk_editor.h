@@ -0,0 +1,144 @@
+/**
+ * @file bulk_editor.h
+ * @brief Shelf-wide edits of many books at once
+ *
+ * Calling Book setters in a loop and saving each book separately takes
+ * minutes on a large library: one transaction, one statement and one
+ * change signal per book. The BulkEditor validates the whole selection
+ * in one pass over the in-memory columns, writes all changes in one
+ * transaction and announces them with a single change event.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef BULK_EDITOR_H
+#define BULK_EDITOR_H
+
+#include "book.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+class Database;
+class BookTable;
+class EditHistory;
+
+/**
+ * @brief Describes a batch of books that changed together
+ */
+struct BookChangeEvent {
+    std::vector<int> bookIds; // every changed book
+    BookFieldMask fields = 0; // union of the fields that changed
+    std::string description; // what the edit did
+};
+
+/**
+ * @brief Outcome of a bulk edit
+ */
+struct BulkEditResult {
+    bool success = false; // false if the write failed (nothing changed then)
+    std::vector<int> changedIds; // books that were changed
+    std::vector<int> rejectedIds; // books that failed validation or don't exist
+    std::string error; // database error when success is false
+};
+
+/**
+ * @brief Applies one operation to many books at once
+ *
+ * Each operation:
+ * 1. scans the current BookTable snapshot once, validating the selected
+ *    rows with the same rules as the Book setters,
+ * 2. writes every accepted change with Database::updateBooks() (a
+ *    single transaction),
+ * 3. merges the changed fields into the current BookTable rows as one
+ *    new version (updates made since the scan are kept),
+ * 4. records one undoable command (if a history is set), and
+ * 5. calls the listener once with a BookChangeEvent.
+ *
+ * Rejected books are reported, not thrown about; the rest still change.
+ */
+class BulkEditor {
+    public:
+        /**
+         * @brief Called once per bulk edit with everything that changed
+         */
+        using Listener = std::function<void(const BookChangeEvent& event)>;
+
+        /**
+         * @brief Constructor
+         * @param database Database to write to
+         * @param table In-memory table to read from and publish to
+         */
+        BulkEditor(Database& database, BookTable& table);
+
+        /**
+         * @brief Record every bulk edit in an undo history
+         * @param history The history (nullptr to stop recording)
+         */
+        void setHistory(EditHistory* history);
+
+        /**
+         * @brief Set the function told about each bulk edit
+         * @param listener The callback
+         */
+        void setListener(Listener listener);
+
+        // ==== OPERATIONS ====
+
+        /**
+         * @brief Reset reading progress (move books back to "To Read")
+         * @param ids The books to reset
+         * @return The outcome
+         */
+        BulkEditResult resetProgress(const std::vector<int>& ids);
+
+        /**
+         * @brief Mark books as completed
+         *
+         * Books with a page count of 0 are rejected, like
+         * Book::markAsCompleted() does. Books that are already completed
+         * are left alone, so they keep their completion date.
+         *
+         * @param ids The books to complete
+         * @return The outcome
+         */
+        BulkEditResult markAsCompleted(const std::vector<int>& ids);
+
+        /**
+         * @brief Set page counts (for example from catalog data)
+         *
+         * Negative counts are rejected. A current page past the new
+         * count is lowered to it, like Book::setPageCount() does.
+         *
+         * @param pageCounts Pairs of (book ID, new page count)
+         * @return The outcome
+         */
+        BulkEditResult setPageCounts(const std::vector<std::pair<int, int>>& pageCounts);
+
+    private:
+        /**
+         * @brief Scan the table and apply an edit to the selected rows
+         *
+         * @param description What the edit does
+         * @param values Selected book IDs with one operation argument each
+         * @param accept Validates a row: bool(int pageCount, int argument)
+         * @param edit Applies the change to a Book copy: void(Book&, int argument)
+         * @return The outcome
+         *
+         * A template (defined in the .cpp, where all callers are) so the
+         * validation inlines into the scan loop.
+         */
+        template <typename Accept, typename Edit>
+        BulkEditResult run(const std::string& description,
+                           const std::vector<std::pair<int, int>>& values,
+                           Accept accept, Edit edit);
+
+        Database& m_database; // where changes are written
+        BookTable& m_table; // where books are read and changes published
+        EditHistory* m_history; // where commands are recorded (optional)
+        Listener m_listener; // told about each bulk edit
+};
+
+#endif // BULK_EDITOR_H
@@ -0,0 +1,224 @@
+/**
+ * @file cover_loader.h
+ * @brief Prioritized, cancellable cover decoding for the cover grid
+ *
+ * Scrolling a grid quickly asks for hundreds of covers a second.
+ * Decoding them in request order keeps the workers busy with covers
+ * that scrolled away long ago, while the ones on screen stay blank.
+ *
+ * The CoverLoader instead decodes what is wanted *now*: the grid
+ * reports its viewport after every scroll, and the queue is reordered
+ * so visible covers come first and nearby ones (prefetch) next. Covers
+ * that left the viewport are cancelled. For each cover a small preview
+ * (the thumbnail many JPEG files carry in their EXIF data) is decoded
+ * before the full image, so the grid fills in quickly and sharpens
+ * afterwards.
+ *
+ * Decoding runs on worker threads. The UI thread collects finished
+ * images once per frame, up to a byte budget, so uploading textures
+ * never stalls a frame.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef COVER_LOADER_H
+#define COVER_LOADER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <optional>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+
+class CoverStore;
+
+/**
+ * @brief Decoded pixels of a cover
+ */
+struct CoverImage {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> rgba; // width * height * 4 bytes
+};
+
+/**
+ * @brief Decodes an encoded image (for example with QImage::fromData)
+ *
+ * @param encoded The file contents
+ * @param maxWidth Width the image will be shown at; the decoder may
+ *                 scale down to it (0: full size)
+ * @return The pixels, or empty if the data cannot be decoded
+ *
+ * Called on worker threads, possibly concurrently.
+ */
+using CoverDecoder = std::function<std::optional<CoverImage>(const std::string& encoded, int maxWidth)>;
+
+/**
+ * @brief Quality of a delivered image
+ */
+enum class CoverQuality {
+    Preview, // embedded thumbnail; the full image follows
+    Full
+};
+
+/**
+ * @brief A cover the grid asks for
+ */
+struct CoverRequest {
+    int itemId; // grid item (usually the book ID)
+    std::string hash; // content hash in the CoverStore
+};
+
+/**
+ * @brief A decoded cover ready to be uploaded
+ */
+struct CoverDelivery {
+    int itemId;
+    std::string hash;
+    CoverQuality quality;
+    CoverImage image;
+};
+
+/**
+ * @brief Extract the thumbnail embedded in a JPEG's EXIF data
+ *
+ * @param encoded The JPEG file contents
+ * @return The thumbnail (itself a JPEG), or empty if there is none
+ */
+std::optional<std::string> extractEmbeddedPreview(const std::string& encoded);
+
+/**
+ * @brief Loads covers for a scrolling grid, most urgent first
+ *
+ * updateViewport() and takeReady() are meant for the UI thread; the
+ * decoding happens on the loader's own workers.
+ */
+class CoverLoader {
+    public:
+        /// Called on a worker when a delivery becomes ready (e.g. to schedule a frame)
+        using ReadyCallback = std::function<void()>;
+
+        // ==== CONSTRUCTOR and DESTRUCTOR ====
+
+        /**
+         * @brief Constructor - starts the decoding workers
+         *
+         * @param store Where covers are read from (must outlive the loader)
+         * @param decoder Decodes images
+         * @param maxWidth Display width passed to the decoder
+         * @param workerCount Decoding threads
+         */
+        CoverLoader(CoverStore& store, CoverDecoder decoder, int maxWidth, std::size_t workerCount = 2);
+
+        /**
+         * @brief Destructor - cancels everything and stops the workers
+         */
+        ~CoverLoader();
+
+        CoverLoader(const CoverLoader&) = delete;
+        CoverLoader& operator=(const CoverLoader&) = delete;
+
+        /**
+         * @brief Set the function called when deliveries become ready
+         * @param callback The callback (may be replaced at any time; it runs
+         *                 on a worker thread, without the loader's lock held)
+         */
+        void setReadyCallback(ReadyCallback callback);
+
+        // ==== REQUESTS ====
+
+        /**
+         * @brief Replace the set of wanted covers
+         *
+         * @param visible Covers on screen, in display order
+         * @param nearby Covers just outside the viewport, nearest first
+         *
+         * Everything else is cancelled: queued work is dropped and
+         * decodes already running are discarded when they finish. Covers
+         * still wanted keep their progress. Covers the grid already shows
+         * at full quality should be left out.
+         */
+        void updateViewport(const std::vector<CoverRequest>& visible,
+                            const std::vector<CoverRequest>& nearby = {});
+
+        /**
+         * @brief Collect decoded covers for this frame
+         *
+         * @param byteBudget Pixel bytes to upload this frame (at least one
+         *                   cover is returned if any is ready)
+         * @return Covers to upload, most urgent first
+         */
+        std::vector<CoverDelivery> takeReady(std::size_t byteBudget);
+
+        /**
+         * @brief Number of covers still to be decoded or collected
+         */
+        std::size_t getPendingCount() const;
+
+    private:
+        /// Queue order: (rank, position in its list, item ID)
+        using QueueKey = std::tuple<int, std::size_t, int>;
+
+        /**
+         * @brief Progress of one wanted cover
+         */
+        struct Entry {
+            std::string hash;
+            bool visible = false;
+            std::size_t position = 0; // index within the visible or nearby list
+            CoverQuality next = CoverQuality::Preview; // stage still to decode
+            bool queued = false; // next stage is in m_queue
+            bool done = false;
+            std::uint64_t generation = 0; // changes when the entry is reset
+            std::string encoded; // file contents, kept between the two stages
+        };
+
+        /**
+         * @brief Queue key of an entry's next stage (lower is more urgent)
+         */
+        static QueueKey makeKey(int itemId, const Entry& entry);
+
+        /**
+         * @brief Add or reposition one wanted cover (m_mutex held)
+         */
+        void want(const CoverRequest& request, bool visible, std::size_t position);
+
+        /**
+         * @brief Body of the decoding workers
+         */
+        void runWorker();
+
+        /**
+         * @brief Decode one stage of a cover (no lock held)
+         * @return The image, or empty if the stage produced nothing
+         */
+        std::optional<CoverImage> decodeStage(const std::string& hash, CoverQuality quality,
+                                              std::string& encoded);
+
+        // ==== MEMBER VARIABLES ====
+
+        CoverStore& m_store; // source of the encoded covers
+        CoverDecoder m_decoder; // turns file contents into pixels
+        int m_maxWidth; // display width passed to the decoder
+
+        mutable std::mutex m_mutex; // guards everything below
+        ReadyCallback m_readyCallback; // signalled when deliveries are ready
+        std::condition_variable m_wake; // work was queued, or stopping
+        std::unordered_map<int, Entry> m_entries; // wanted covers by item ID
+        std::set<QueueKey> m_queue; // stages waiting for a worker, most urgent first
+        std::deque<CoverDelivery> m_ready; // decoded, not collected yet
+        std::uint64_t m_nextGeneration;
+        bool m_stopping;
+        std::vector<std::thread> m_workers;
+};
+
+#endif // COVER_LOADER_H
@@ -0,0 +1,189 @@
+/**
+ * @file cover_store.h
+ * @brief Content-addressed storage for cover images
+ *
+ * The same cover often belongs to several editions or duplicate entries.
+ * CoverStore keeps each distinct image once, named by the SHA-256 of its
+ * bytes, in a two-level sharded directory tree:
+ *
+ *     <root>/3a/7f/3a7f...e1
+ *
+ * Finding a cover is a path computation; no directory is ever listed.
+ * The database maps books to hashes and counts the references, so a
+ * cover shared by ten books is written once and deleted only after the
+ * last of them lets go of it (and a grace period has passed).
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef COVER_STORE_H
+#define COVER_STORE_H
+
+#include <string>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstddef>
+
+class Database;
+
+/**
+ * @brief What a garbage collection pass removed
+ */
+struct CoverCollection {
+    std::size_t covers = 0; // unreferenced covers deleted
+    std::size_t orphans = 0; // files without a database record deleted
+    std::size_t tempFiles = 0; // leftovers of interrupted writes deleted
+};
+
+/**
+ * @brief Stores cover images by content hash
+ *
+ * Files are written to a temporary name, flushed and renamed into
+ * place, so a reader never sees a partial cover and a crash leaves at
+ * most a stray temporary file behind.
+ *
+ * Covers must be attached through setBookCover() (not Database directly):
+ * it serializes against the garbage collector, so a cover is never
+ * deleted between being written and being referenced.
+ */
+class CoverStore {
+    public:
+        // ==== CONSTRUCTOR and DESTRUCTOR ====
+
+        /**
+         * @brief Constructor - opens (and creates) the store
+         * @param rootDir Directory holding the covers
+         * @throws std::runtime_error if the directory cannot be created
+         */
+        explicit CoverStore(const std::string& rootDir);
+
+        /**
+         * @brief Destructor - stops the background collector
+         */
+        ~CoverStore();
+
+        CoverStore(const CoverStore&) = delete;
+        CoverStore& operator=(const CoverStore&) = delete;
+
+        // ==== CONTENT ====
+
+        /**
+         * @brief Compute the content hash of an image
+         * @param data The image bytes
+         * @return Lower-case hex SHA-256
+         */
+        static std::string hashContent(const std::string& data);
+
+        /**
+         * @brief Get the file path of a cover
+         * @param hash Content hash of the cover
+         * @return The path (the file may not exist)
+         */
+        std::string getPath(const std::string& hash) const;
+
+        /**
+         * @brief Store an image, unless an identical one is stored already
+         *
+         * @param data The image bytes
+         * @return Its content hash, or empty if it could not be written
+         *
+         * The image is not referenced by any book yet; use setBookCover().
+         */
+        std::optional<std::string> put(const std::string& data);
+
+        /**
+         * @brief Read a cover
+         * @param hash Content hash of the cover
+         * @return The image bytes, or empty if it is missing
+         */
+        std::optional<std::string> read(const std::string& hash) const;
+
+        // ==== BOOK COVERS ====
+
+        /**
+         * @brief Store an image and make it a book's cover
+         *
+         * @param database Database holding the book
+         * @param bookId The book
+         * @param data The image bytes
+         * @return The cover's content hash, or empty on failure
+         *
+         * The book's previous cover loses a reference.
+         */
+        std::optional<std::string> setBookCover(Database& database, int bookId, const std::string& data);
+
+        /**
+         * @brief Remove a book's cover
+         * @return True on success
+         */
+        bool clearBookCover(Database& database, int bookId);
+
+        // ==== GARBAGE COLLECTION ====
+
+        /**
+         * @brief Delete covers no book has used for a while
+         *
+         * @param database Database holding the reference counts
+         * @param gracePeriod How long a cover stays after its last reference
+         *                    goes (so undoing a delete finds it again)
+         * @param sweepOrphans Also list the store and delete files the
+         *                     database does not know (left by a crash
+         *                     between writing and referencing). This is
+         *                     the only operation that scans directories.
+         * @return What was removed
+         */
+        CoverCollection collectGarbage(Database& database, std::chrono::seconds gracePeriod,
+                                       bool sweepOrphans = false);
+
+        /**
+         * @brief Run collectGarbage() periodically on a background thread
+         *
+         * @param dbPath Path of the database (the collector opens its own
+         *               connection)
+         * @param interval Time between passes
+         * @param gracePeriod Passed on to collectGarbage()
+         * @throws std::runtime_error if the database cannot be opened
+         */
+        void startCollector(const std::string& dbPath, std::chrono::seconds interval,
+                            std::chrono::seconds gracePeriod);
+
+        /**
+         * @brief Stop the background collector and wait for it to exit
+         */
+        void stopCollector();
+
+    private:
+        /**
+         * @brief Write a file atomically (temporary file, fsync, rename, directory fsync)
+         * @return True on success
+         */
+        bool writeAtomically(const std::string& path, const std::string& data);
+
+        /**
+         * @brief Delete temporary files older than the grace period
+         * @return Number deleted
+         */
+        std::size_t removeStaleTempFiles(std::chrono::seconds gracePeriod);
+
+        /**
+         * @brief Delete cover files the database does not know
+         * @return Number deleted
+         */
+        std::size_t removeOrphans(Database& database, std::chrono::seconds gracePeriod);
+
+        // ==== MEMBER VARIABLES ====
+
+        std::string m_root; // store directory
+        std::string m_tempDir; // where files are written before the rename
+        std::mutex m_mutex; // serializes referencing covers against deleting them
+        std::thread m_collector; // background garbage collector
+        std::mutex m_collectorMutex; // guards m_stopping
+        std::condition_variable m_collectorWake; // signalled by stopCollector()
+        bool m_stopping; // asks the collector to exit
+};
+
+#endif // COVER_STORE_H
@@ -13,9 +13,29 @@
  #define DATABASE_H
 
  #include "book.h"
+ #include "book_fields.h"
+ #include "reading_event.h"
+ #include "sort_key.h"
  #include <sqlite3.h>
  #include <vector>
  #include <string>
+ #include <optional>
+ #include <functional>
+ #include <memory>
+ #include <cstdint>
+ #include <chrono>
+
+/**
+ * @brief How far an activity log has been applied
+ *
+ * The inode identifies the file across renames, so a rotated log is
+ * not mistaken for the one we were reading.
+ */
+struct LogCheckpoint {
+    std::string path; // path the log is tailed at
+    std::uint64_t inode = 0; // inode of the file the offset belongs to
+    std::int64_t offset = 0; // bytes already applied (always at a line start)
+};
 
 /**
  * @brief Manages databse operations for the PRMS application
@@ -56,9 +76,372 @@
      */
     ~Database();
 
+    // The connection is a unique resource, so a Database cannot be copied
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
+
     // ==== DATABASE INITIALIZATION ====
 
-    
- }
+    /**
+     * @brief Create the schema if it does not exist yet
+     * @return True on success, false on error (see getLastError())
+     */
+    bool initialize();
+
+    /**
+     * @brief Check whether the connection is open
+     * @return True if the database can be used
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get the message of the last failed operation
+     * @return Error message (empty if nothing failed yet)
+     */
+    const std::string& getLastError() const;
+
+    // ==== TRANSACTIONS ====
+
+    /**
+     * @brief Start a transaction
+     * @return True on success
+     */
+    bool beginTransaction();
+
+    /**
+     * @brief Commit the current transaction
+     * @return True on success
+     */
+    bool commitTransaction();
+
+    /**
+     * @brief Roll back the current transaction
+     * @return True on success
+     */
+    bool rollbackTransaction();
+
+    // ==== BOOK OPERATIONS ====
+
+    /**
+     * @brief Save a new book
+     *
+     * @param book The book to save (its ID is ignored)
+     * @return The ID assigned by the database, or 0 on error (then
+     *         nothing is stored)
+     */
+    int addBook(const Book& book);
+
+    /**
+     * @brief Update an existing book
+     *
+     * @param book The book to update (matched by ID)
+     * @return True if a row was updated
+     *
+     * Only the fields the book actually holds (see Book::getLoadedFields())
+     * are written, so a partially loaded book never overwrites columns it
+     * did not read or set. The row, texts and sort keys are written in
+     * one savepoint; nothing is written for a book that does not exist.
+     */
+    bool updateBook(const Book& book);
+
+    /**
+     * @brief Update many books in one transaction
+     *
+     * @param books The books to update (matched by ID)
+     * @return True if every update succeeded; otherwise nothing is written
+     *
+     * Like updateBook(), only loaded fields are written. Books that are
+     * no longer in the database are skipped. Books that
+     * change the same set of fields share one prepared statement, so
+     * this is the path for bulk edits.
+     */
+    bool updateBooks(const std::vector<Book>& books);
+
+    /**
+     * @brief Delete a book
+     * @param id The ID of the book to delete
+     * @return True if a row was deleted
+     */
+    bool deleteBook(int id);
+
+    /**
+     * @brief Load a single book
+     *
+     * @param id The ID of the book to load
+     * @param fields The fields to read (defaults to all of them)
+     * @return The book, or empty if it doesn't exist or an error occurred
+     *
+     * Only the projected columns are read from disk. The ID is always
+     * loaded. Check Book::hasField() before using any other field.
+     * Projected reviews and notes are attached as deferred LazyText
+     * handles that read from this Database on first access.
+     */
+    std::optional<Book> loadBook(int id, BookFieldMask fields = kAllBookFields);
+
+    /**
+     * @brief Load every book in the collection
+     *
+     * @param fields The fields to read (defaults to all of them)
+     * @return All books ordered by ID (empty on error)
+     *
+     * List views should pass kListViewFields so that long text columns
+     * are never read or copied into strings.
+     */
+    std::vector<Book> loadAllBooks(BookFieldMask fields = kAllBookFields);
+
+    /**
+     * @brief Load every book in collated order
+     *
+     * @param order Which sort keys to order by
+     * @param fields The fields to read (defaults to all of them)
+     * @return All books in order (empty on error, or if no sort key
+     *         generator is set)
+     *
+     * The ordering is an indexed ORDER BY over the sort key BLOBs, so
+     * SQLite compares them with memcmp and never collates strings.
+     */
+    std::vector<Book> loadBooksInCollatedOrder(CollatedOrder order,
+                                               BookFieldMask fields = kAllBookFields);
+
+    // ==== SORT KEYS ====
+
+    /**
+     * @brief Set the locale the stored sort keys are generated for
+     *
+     * @param generator The generator (null stops maintaining keys)
+     * @return True on success
+     *
+     * If the stored keys belong to a different locale (or are missing)
+     * they are regenerated for every book in one transaction. After
+     * that, addBook(), updateBook() and updateBooks() keep them current.
+     */
+    bool setSortKeyGenerator(std::shared_ptr<const SortKeyGenerator> generator);
+
+    /**
+     * @brief Regenerate the stored sort keys of every book
+     * @return True on success
+     */
+    bool rebuildSortKeys();
+
+    // ==== TEXT SIDE STORAGE ====
+
+    /**
+     * @brief Save a review or notes body for a book
+     *
+     * @param bookId The book the text belongs to
+     * @param kind Which text to save
+     * @param body The text (empty removes it)
+     * @return True on success
+     *
+     * Texts live in the book_texts table, not in the books row, so
+     * scans over the core book columns stay small however long the
+     * reviews get.
+     */
+    bool saveText(int bookId, BookTextKind kind, const std::string& body);
+
+    /**
+     * @brief Read a whole review or notes body
+     *
+     * @param bookId The book the text belongs to
+     * @param kind Which text to read
+     * @return The text (empty if there is none or on error)
+     */
+    std::string loadText(int bookId, BookTextKind kind);
+
+    /**
+     * @brief Read a review or notes body in chunks
+     *
+     * @param bookId The book the text belongs to
+     * @param kind Which text to read
+     * @param sink Called with each chunk; return false to stop early
+     * @param chunkSize Maximum number of bytes per chunk
+     * @return True if the text was read (or there was none), false on error
+     *
+     * Uses SQLite incremental blob I/O, so a large body is never held in
+     * memory all at once.
+     */
+    bool streamText(int bookId, BookTextKind kind,
+                    const std::function<bool(const char* data, std::size_t size)>& sink,
+                    std::size_t chunkSize = 64 * 1024);
+
+    // ==== READING ACTIVITY ====
+
+    /**
+     * @brief Record reading events and apply them as progress updates
+     *
+     * @param events Events in log order
+     * @return True on success
+     *
+     * Every event is stored in the reading_events table, and the book's
+     * current page follows the same rules as Book::setCurrentPage(): the
+     * start date is set on the first page read and the completion date
+     * when the last page is reached, both using the event's timestamp.
+     * Pages past the end are capped at the page count.
+     *
+     * Call this inside a transaction to apply a batch all-or-nothing.
+     */
+    bool applyReadingEvents(const std::vector<ReadingEvent>& events);
+
+    /**
+     * @brief Load the checkpoint of an activity log
+     * @param path The log path
+     * @return The checkpoint, or empty if the log was never read
+     */
+    std::optional<LogCheckpoint> loadLogCheckpoint(const std::string& path);
+
+    /**
+     * @brief Save the checkpoint of an activity log
+     * @param checkpoint The new checkpoint
+     * @return True on success
+     */
+    bool saveLogCheckpoint(const LogCheckpoint& checkpoint);
+
+    // ==== COVERS ====
+
+    /**
+     * @brief Point a book at a stored cover, or clear its cover
+     *
+     * @param bookId The book
+     * @param hash Content hash of the cover (empty clears the cover)
+     * @param size Size of the cover file in bytes
+     * @return True on success
+     *
+     * Maintains the reference counts of the old and new covers. A cover
+     * whose count drops to zero is stamped so the garbage collector can
+     * delete it after a grace period.
+     */
+    bool setBookCover(int bookId, const std::string& hash, std::int64_t size);
+
+    /**
+     * @brief Get the content hash of a book's cover
+     * @param bookId The book
+     * @return The hash, or empty if the book has no cover
+     */
+    std::optional<std::string> getBookCover(int bookId);
+
+    /**
+     * @brief Get the number of books using a cover
+     * @param hash Content hash of the cover
+     * @return The reference count, 0 if unknown, or -1 on error
+     */
+    int getCoverRefCount(const std::string& hash);
+
+    /**
+     * @brief Find covers no book has used for a while
+     * @param before Only covers unreferenced since before this time
+     * @return Their content hashes
+     */
+    std::vector<std::string> findUnreferencedCovers(std::chrono::system_clock::time_point before);
+
+    /**
+     * @brief Forget a cover if it is still unreferenced
+     * @param hash Content hash of the cover
+     * @return True if the record was deleted (the file may go too)
+     */
+    bool deleteUnreferencedCover(const std::string& hash);
+
+    /**
+     * @brief Check whether a cover is known
+     * @param hash Content hash of the cover
+     * @return True if a record exists (referenced or not), and on
+     *         error, so a caller never deletes a cover it cannot check
+     */
+    bool hasCover(const std::string& hash);
+
+    /**
+     * @brief Count the books in the collection
+     * @return Number of books, or -1 on error
+     */
+    int getBookCount();
+
+    private:
+
+    // ==== HELPER METHODS ====
+
+    /**
+     * @brief Execute SQL that returns no rows
+     * @param sql The statement(s) to run
+     * @return True on success
+     */
+    bool execute(const std::string& sql);
+
+    /**
+     * @brief Add schema fields that an older books table is missing
+     * @return True on success
+     */
+    bool addMissingColumns();
+
+    /**
+     * @brief Build the column list for a projection
+     * @param fields The projected fields (ID is always added)
+     * @return Comma separated column names in BookField bit order
+     */
+    static std::string buildColumnList(BookFieldMask fields);
+
+    /**
+     * @brief Build an UPDATE statement for a set of fields
+     * @param fields Core fields to set (without the ID)
+     * @return SQL with one parameter per field, then the ID
+     */
+    static std::string buildUpdateSql(BookFieldMask fields);
+
+    /**
+     * @brief Bind a book to a statement built by buildUpdateSql()
+     */
+    static void bindUpdate(sqlite3_stmt* stmt, const Book& book, BookFieldMask fields);
+
+    /**
+     * @brief Fill a book from the current row of a statement
+     *
+     * @param stmt Statement positioned on a row
+     * @param fields The projection used to build the statement
+     * @return The (possibly partial) book
+     */
+    Book readBook(sqlite3_stmt* stmt, BookFieldMask fields);
+
+    /**
+     * @brief Write the modified texts of a book to side storage
+     * @param book The book whose reviews/notes should be saved
+     * @return True on success
+     */
+    bool saveModifiedTexts(const Book& book);
+
+    struct UpdateCache; // last prepared UPDATE of a batch
+
+    /**
+     * @brief Write one book's loaded fields, then its texts and sort keys
+     *
+     * @param book The book (matched by ID)
+     * @param cache Reuses its UPDATE statement when the fields match
+     * @param found Set to whether the book exists; if not, nothing is written
+     * @return False on a database error
+     */
+    bool writeBook(const Book& book, UpdateCache& cache, bool& found);
+
+    /**
+     * @brief Refresh the stored sort keys of a book after a write
+     *
+     * @param id The ID of the book
+     * @param book The book that was written
+     * @param fields The core fields that were written
+     * @return True on success (or if no keys are maintained)
+     */
+    bool saveSortKeys(int id, const Book& book, BookFieldMask fields);
+
+    /**
+     * @brief Remember the current SQLite error message
+     * @param context What was being done when the error happened
+     */
+    void setError(const std::string& context);
+
+    // ==== MEMBER VARIABLES ====
+
+    sqlite3* m_db; // handle to the open SQLite connection
+    std::shared_ptr<sqlite3> m_connection; // owns m_db; shared with deferred texts
+    std::string m_lastError; // message of the last failed operation
+    std::shared_ptr<const SortKeyGenerator> m_sortKeys; // locale of book_sort_keys (may be null)
+ };
+
+ #endif // DATABASE_H
 
     
\ No newline at end of file
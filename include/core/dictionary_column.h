@@ -0,0 +1,303 @@
+/**
+ * @file dictionary_column.h
+ * @brief Dictionary and run-length encoded column for BookTable chunks
+ *
+ * Genre, publisher and year have few distinct values, so storing them
+ * once per row wastes memory (a std::string is 32 bytes before its
+ * heap buffer). A DictionaryColumn stores each distinct value once per
+ * chunk and a 16-bit code per row. When a chunk is sealed and the codes
+ * form long runs, they are stored run-length encoded instead.
+ *
+ * Filters never decode values: a predicate is evaluated once per
+ * dictionary entry, and the rows are then filtered by code.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef DICTIONARY_COLUMN_H
+#define DICTIONARY_COLUMN_H
+
+#include "memory_budget.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief A column of T values stored as codes into a dictionary
+ *
+ * @tparam T The value type (std::string or int)
+ *
+ * Codes are 16 bits, which covers any chunk (kBookChunkCapacity rows).
+ * Like the rest of a chunk, a column is only modified by the writer that
+ * built it and is read-only once published.
+ */
+template <typename T>
+class DictionaryColumn {
+    public:
+        using Code = std::uint16_t;
+
+        /**
+         * @brief Number of rows
+         */
+        std::size_t size() const {
+            return m_runLength ? (m_runEnds.empty() ? 0 : m_runEnds.back()) : m_codes.size();
+        }
+
+        /**
+         * @brief Value of one row
+         * @param row Row index (must be < size())
+         */
+        const T& get(std::size_t row) const {
+            return m_values[codeAt(row)];
+        }
+
+        /**
+         * @brief Dictionary code of one row
+         * @param row Row index (must be < size())
+         */
+        Code codeAt(std::size_t row) const {
+            if (!m_runLength) {
+                return m_codes[row];
+            }
+            auto run = std::upper_bound(m_runEnds.begin(), m_runEnds.end(),
+                                        static_cast<std::uint32_t>(row));
+            return m_runCodes[static_cast<std::size_t>(run - m_runEnds.begin())];
+        }
+
+        /**
+         * @brief The distinct values, indexed by code
+         */
+        const std::vector<T>& getDictionary() const {
+            return m_values;
+        }
+
+        /**
+         * @brief Check whether the codes are stored run-length encoded
+         */
+        bool isRunLength() const {
+            return m_runLength;
+        }
+
+        /**
+         * @brief Approximate heap bytes of the dictionary, codes and runs
+         *
+         * The write-time lookup map is not included; seal() frees it.
+         */
+        std::size_t getMemoryUsage() const {
+            return heapBytes(m_values) + heapBytes(m_codes) + heapBytes(m_runCodes) +
+                   heapBytes(m_runEnds);
+        }
+
+        // ==== WRITING ====
+
+        /**
+         * @brief Append a row
+         */
+        void push(const T& value) {
+            expand();
+            m_codes.push_back(encode(value));
+        }
+
+        /**
+         * @brief Overwrite one row
+         * @param row Row index (must be < size())
+         */
+        void set(std::size_t row, const T& value) {
+            if (m_values[codeAt(row)] == value) {
+                return; // The common case: an unrelated field changed
+            }
+            expand();
+            m_codes[row] = encode(value);
+        }
+
+        /**
+         * @brief Move the last row into a row, then drop the last row
+         * @param row Row index (must be < size())
+         */
+        void swapRemove(std::size_t row) {
+            expand();
+            m_codes[row] = m_codes.back();
+            m_codes.pop_back();
+        }
+
+        /**
+         * @brief Finish writing: drop unused values and pick the encoding
+         *
+         * Called on a chunk before it is published. Codes switch to runs
+         * when that takes at most half the space: a run costs 6 bytes,
+         * a plain code 2.
+         */
+        void seal() {
+            expand();
+            compact();
+            m_lookup.clear();
+
+            std::size_t runs = 0;
+            for (std::size_t i = 0; i < m_codes.size(); ++i) {
+                runs += i == 0 || m_codes[i] != m_codes[i - 1];
+            }
+            if (runs * 6 > m_codes.size()) {
+                m_codes.shrink_to_fit();
+                return;
+            }
+
+            m_runCodes.clear();
+            m_runEnds.clear();
+            for (std::size_t i = 0; i < m_codes.size(); ++i) {
+                if (i == 0 || m_codes[i] != m_codes[i - 1]) {
+                    m_runCodes.push_back(m_codes[i]);
+                    m_runEnds.push_back(0);
+                }
+                m_runEnds.back() = static_cast<std::uint32_t>(i + 1);
+            }
+            m_codes.clear();
+            m_codes.shrink_to_fit();
+            m_runLength = true;
+        }
+
+        // ==== FILTERING ====
+
+        /**
+         * @brief Evaluate a predicate once per dictionary value
+         *
+         * @param predicate Called with each distinct value
+         * @param matches Set to one flag per code
+         * @return True if any value matched (false: the chunk can be skipped)
+         */
+        template <typename Predicate>
+        bool matchCodes(Predicate predicate, std::vector<std::uint8_t>& matches) const {
+            matches.resize(m_values.size());
+            bool any = false;
+            for (std::size_t code = 0; code < m_values.size(); ++code) {
+                matches[code] = predicate(m_values[code]) ? 1 : 0;
+                any = any || matches[code] != 0;
+            }
+            return any;
+        }
+
+        /**
+         * @brief Keep only the selected rows whose code matches
+         *
+         * @param rows Selection vector, ascending (refined in place)
+         * @param count Number of selected rows
+         * @param matches Flags from matchCodes()
+         * @return Number of rows kept
+         *
+         * Plain codes are tested with a branch-free gather; runs are
+         * walked alongside the (ascending) rows, so a run-length column is
+         * never decoded.
+         */
+        std::size_t refine(std::uint32_t* rows, std::size_t count,
+                           const std::vector<std::uint8_t>& matches) const {
+            std::size_t kept = 0;
+            if (!m_runLength) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    rows[kept] = rows[i];
+                    kept += matches[m_codes[rows[i]]];
+                }
+                return kept;
+            }
+
+            std::size_t run = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                while (m_runEnds[run] <= rows[i]) {
+                    ++run;
+                }
+                rows[kept] = rows[i];
+                kept += matches[m_runCodes[run]];
+            }
+            return kept;
+        }
+
+    private:
+        /// Below this many values a linear search beats building the lookup map
+        static constexpr std::size_t kLinearSearchLimit = 16;
+
+        /**
+         * @brief Find the code of a value, adding it if it is new
+         */
+        Code encode(const T& value) {
+            if (m_values.size() <= kLinearSearchLimit) {
+                auto found = std::find(m_values.begin(), m_values.end(), value);
+                if (found != m_values.end()) {
+                    return static_cast<Code>(found - m_values.begin());
+                }
+            } else {
+                if (m_lookup.empty()) {
+                    for (std::size_t code = 0; code < m_values.size(); ++code) {
+                        m_lookup.emplace(m_values[code], static_cast<Code>(code));
+                    }
+                }
+                auto found = m_lookup.find(value);
+                if (found != m_lookup.end()) {
+                    return found->second;
+                }
+            }
+
+            Code code = static_cast<Code>(m_values.size());
+            m_values.push_back(value);
+            if (!m_lookup.empty()) {
+                m_lookup.emplace(value, code);
+            }
+            return code;
+        }
+
+        /**
+         * @brief Switch back to plain codes before a write
+         */
+        void expand() {
+            if (!m_runLength) {
+                return;
+            }
+            m_codes.clear();
+            m_codes.reserve(size());
+            std::uint32_t begin = 0;
+            for (std::size_t run = 0; run < m_runCodes.size(); ++run) {
+                m_codes.insert(m_codes.end(), m_runEnds[run] - begin, m_runCodes[run]);
+                begin = m_runEnds[run];
+            }
+            m_runCodes.clear();
+            m_runCodes.shrink_to_fit();
+            m_runEnds.clear();
+            m_runEnds.shrink_to_fit();
+            m_runLength = false;
+        }
+
+        /**
+         * @brief Drop dictionary values no row uses any more
+         */
+        void compact() {
+            std::vector<Code> remap(m_values.size(), 0);
+            std::vector<std::uint8_t> used(m_values.size(), 0);
+            for (Code code : m_codes) {
+                used[code] = 1;
+            }
+            if (std::find(used.begin(), used.end(), 0) == used.end()) {
+                return;
+            }
+
+            std::vector<T> values;
+            for (std::size_t code = 0; code < m_values.size(); ++code) {
+                if (used[code]) {
+                    remap[code] = static_cast<Code>(values.size());
+                    values.push_back(std::move(m_values[code]));
+                }
+            }
+            for (Code& code : m_codes) {
+                code = remap[code];
+            }
+            m_values.swap(values);
+        }
+
+        std::vector<T> m_values; // distinct values, indexed by code
+        std::vector<Code> m_codes; // one code per row (plain form)
+        std::vector<Code> m_runCodes; // code of each run (run-length form)
+        std::vector<std::uint32_t> m_runEnds; // exclusive end row of each run
+        bool m_runLength = false; // which of the two forms is in use
+        std::unordered_map<T, Code> m_lookup; // value -> code while writing large dictionaries
+};
+
+#endif // DICTIONARY_COLUMN_H
@@ -0,0 +1,153 @@
+/**
+ * @file edit_history.h
+ * @brief Undo and redo for (bulk) edits of the book collection
+ *
+ * Every edit is recorded as a command that holds only the fields that
+ * changed, before and after. Undoing a command writes those old values
+ * back: to the database as partial updates touching only the changed
+ * columns, and to the in-memory BookTable as one new version that
+ * copies only the affected chunks.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef EDIT_HISTORY_H
+#define EDIT_HISTORY_H
+
+#include "book.h"
+#include "memory_budget.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstddef>
+
+class Database;
+class BookTable;
+
+/**
+ * @brief The change made to one book
+ *
+ * Both books are partial: apart from the ID they only hold the fields
+ * that changed (see Book::getLoadedFields()).
+ */
+struct BookChange {
+    Book before;
+    Book after;
+};
+
+/**
+ * @brief One undoable edit, possibly touching thousands of books
+ */
+struct EditCommand {
+    std::string description; // shown in the Edit menu ("Reset progress on 'Sci-Fi'")
+    std::vector<BookChange> changes; // one entry per changed book
+    std::size_t memoryBytes = 0; // estimated heap footprint, set by EditHistory::record()
+};
+
+/**
+ * @brief Keeps the undo and redo stacks of edit commands
+ *
+ * Memory is proportional to the number of changed fields, never to the
+ * size of the library. Both stacks are charged to the EditHistory
+ * subsystem; when that is over its budget, or there are more commands
+ * than allowed, the command furthest from the present (the oldest undo
+ * or the last redo) is dropped first. The nearest one is always kept.
+ */
+class EditHistory {
+    public:
+        /**
+         * @brief Constructor - creates an empty history
+         * @param maxCommands How many commands to keep for undo and redo together
+         */
+        explicit EditHistory(std::size_t maxCommands = 100);
+
+        /**
+         * @brief Build a command by comparing books before and after an edit
+         *
+         * @param description What the edit did
+         * @param before The books before the edit
+         * @param after The same books (same order) after the edit
+         * @return The command; books without changes are left out
+         */
+        static EditCommand makeCommand(const std::string& description,
+                                       const std::vector<Book>& before,
+                                       const std::vector<Book>& after);
+
+        /**
+         * @brief Record a command that was just applied
+         *
+         * Clears the redo stack. Empty commands are ignored.
+         *
+         * @param command The applied command
+         */
+        void record(EditCommand command);
+
+        /**
+         * @brief Check whether there is something to undo
+         */
+        bool canUndo() const;
+
+        /**
+         * @brief Check whether there is something to redo
+         */
+        bool canRedo() const;
+
+        /**
+         * @brief Description of the command undo() would revert
+         * @return The description (empty if there is nothing to undo)
+         */
+        std::string getUndoDescription() const;
+
+        /**
+         * @brief Description of the command redo() would apply again
+         * @return The description (empty if there is nothing to redo)
+         */
+        std::string getRedoDescription() const;
+
+        /**
+         * @brief Revert the most recent command
+         *
+         * @param database Database to write the old values to
+         * @param table In-memory table to write the old values to
+         * @return True on success; on failure nothing is changed
+         */
+        bool undo(Database& database, BookTable& table);
+
+        /**
+         * @brief Apply the most recently undone command again
+         *
+         * @param database Database to write the new values to
+         * @param table In-memory table to write the new values to
+         * @return True on success; on failure nothing is changed
+         */
+        bool redo(Database& database, BookTable& table);
+
+        /**
+         * @brief Forget all commands
+         */
+        void clear();
+
+    private:
+        /**
+         * @brief Write one side of a command to the database and table
+         *
+         * @param command The command to write
+         * @param useBefore True to write the old values, false for the new ones
+         * @return True on success
+         */
+        static bool applyCommand(const EditCommand& command, bool useBefore,
+                                 Database& database, BookTable& table);
+
+        /**
+         * @brief Drop commands past the command limit or the memory budget
+         */
+        void trim();
+
+        std::deque<EditCommand> m_undoStack; // oldest command at the front
+        std::deque<EditCommand> m_redoStack; // most recently undone at the back
+        std::size_t m_maxCommands; // oldest commands are dropped past this
+        MemoryCharge m_memory; // bytes of both stacks
+};
+
+#endif // EDIT_HISTORY_H
@@ -0,0 +1,163 @@
+/**
+ * @file factor_file.h
+ * @brief Memory-mapped item factors for offline recommendations (FR-041, NFR-014)
+ *
+ * Recommendations come from collaborative filtering, but no reading data
+ * may leave the machine. The prms_als tool therefore trains a matrix
+ * factorization offline, on a public ratings dump on local disk, and
+ * writes the item factors to a compact file. At runtime the file is
+ * memory-mapped: opening it costs nothing, only the pages touched are
+ * read, and several processes share them.
+ *
+ * File layout (little-endian, items sorted by key):
+ *
+ *     header     FactorFileHeader
+ *     vectors    itemCount * rank floats, 64-byte aligned
+ *     offsets    itemCount + 1 uint32 offsets into the key bytes
+ *     keys       the keys (normalized ISBN-13), concatenated
+ *
+ * The user's profile is built from the books they completed, matched by
+ * ISBN, and every catalog item is scored by its dot product with it.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef FACTOR_FILE_H
+#define FACTOR_FILE_H
+
+#include "book.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// Identifies factor files (and their version)
+constexpr char kFactorFileMagic[8] = { 'P', 'R', 'M', 'S', 'A', 'L', 'S', '1' };
+
+/**
+ * @brief Fixed-size start of a factor file
+ */
+struct FactorFileHeader {
+    char magic[8];
+    std::uint32_t rank; // floats per vector
+    std::uint32_t reserved;
+    std::uint64_t itemCount;
+    std::uint64_t vectorsOffset;
+    std::uint64_t keyOffsetsOffset;
+    std::uint64_t keysOffset;
+    std::uint64_t fileSize;
+    float globalMean; // mean rating of the training data
+    float padding;
+};
+
+/**
+ * @brief An item and its score
+ */
+struct ItemScore {
+    std::uint32_t item; // index in the factor file
+    float score;
+};
+
+/**
+ * @brief Normalize an ISBN to the 13-digit form used as key
+ *
+ * @param isbn ISBN-10 or ISBN-13, with or without hyphens and spaces
+ * @return The ISBN-13 digits, or empty if it is not a well-formed ISBN
+ */
+std::string normalizeIsbn(const std::string& isbn);
+
+/**
+ * @brief Write a factor file atomically
+ *
+ * @param path Destination
+ * @param rank Floats per vector
+ * @param globalMean Mean rating of the training data
+ * @param keys One key per item
+ * @param vectors keys.size() * rank floats, item by item
+ * @return True on success
+ */
+bool writeFactorFile(const std::string& path, std::uint32_t rank, float globalMean,
+                     const std::vector<std::string>& keys, const std::vector<float>& vectors);
+
+/**
+ * @brief A factor file mapped into memory (read-only)
+ */
+class FactorFile {
+    public:
+        /**
+         * @brief Constructor - maps a factor file
+         * @param path The file
+         * @throws std::runtime_error if it cannot be mapped or is malformed
+         */
+        explicit FactorFile(const std::string& path);
+
+        /**
+         * @brief Destructor - unmaps the file
+         */
+        ~FactorFile();
+
+        FactorFile(const FactorFile&) = delete;
+        FactorFile& operator=(const FactorFile&) = delete;
+
+        std::uint32_t getRank() const;
+        std::size_t getItemCount() const;
+        float getGlobalMean() const;
+
+        /**
+         * @brief Key (normalized ISBN) of an item
+         */
+        std::string getKey(std::size_t item) const;
+
+        /**
+         * @brief Find an item by key
+         * @param key Normalized ISBN (see normalizeIsbn())
+         * @return The item index, or -1 if the catalog does not have it
+         */
+        std::int64_t findItem(const std::string& key) const;
+
+        /**
+         * @brief The factor vector of an item (getRank() floats)
+         */
+        const float* getVector(std::size_t item) const;
+
+    private:
+        void* m_data; // the mapping
+        std::size_t m_size; // its length
+        const FactorFileHeader* m_header;
+        const float* m_vectors;
+        const std::uint32_t* m_keyOffsets;
+        const char* m_keys;
+};
+
+// ==== SCORING ====
+
+/**
+ * @brief Items of the catalog the user has completed
+ *
+ * @param factors The catalog
+ * @param history The user's books (ISBN and completion needed)
+ * @return Item indexes, without duplicates
+ */
+std::vector<std::uint32_t> findCompletedItems(const FactorFile& factors, const std::vector<Book>& history);
+
+/**
+ * @brief The user's taste vector: the mean of their completed items
+ *
+ * @return getRank() floats, all zero if no item matched
+ */
+std::vector<float> buildProfile(const FactorFile& factors, const std::vector<std::uint32_t>& items);
+
+/**
+ * @brief Best items for a profile
+ *
+ * @param factors The catalog
+ * @param profile The taste vector
+ * @param k How many items to return
+ * @param exclude Items not to recommend (for example the history)
+ * @return Up to k items, best first
+ */
+std::vector<ItemScore> scoreItems(const FactorFile& factors, const std::vector<float>& profile,
+                                  std::size_t k, const std::vector<std::uint32_t>& exclude = {});
+
+#endif // FACTOR_FILE_H
@@ -0,0 +1,80 @@
+/**
+ * @file factor_support.h
+ * @brief Internal helpers shared by the factor files, the recommender and the speed model
+ *
+ * Not part of the public API: bounds checks for mapped files, the
+ * durable write step, top-k ranking of item scores and run-time AVX2
+ * detection for the gather kernels.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef FACTOR_SUPPORT_H
+#define FACTOR_SUPPORT_H
+
+#include "factor_file.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PRMS_HAVE_AVX2_GATHER 1
+#include <immintrin.h>
+#endif
+
+// ==== MAPPED FILES ====
+
+/**
+ * @brief Whether count elements of elementSize bytes fit between offset
+ *        and size (without overflowing, whatever the header says)
+ */
+inline bool fitsIn(std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize, std::uint64_t size) {
+    return offset <= size && count <= (size - offset) / elementSize;
+}
+
+/**
+ * @brief Flush a written file to disk (before it is renamed into place)
+ * @param path The file to flush
+ * @return True on success
+ */
+bool syncFile(const std::string& path);
+
+// ==== RANKING ====
+
+/**
+ * @brief Ranks scores: higher first, then the lower item index
+ */
+inline bool isBetter(const ItemScore& a, const ItemScore& b) {
+    return a.score != b.score ? a.score > b.score : a.item < b.item;
+}
+
+/**
+ * @brief Offer a score to a min-heap of the best k (worst on top)
+ */
+inline void offer(std::vector<ItemScore>& heap, std::size_t k, const ItemScore& candidate) {
+    if (heap.size() < k) {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end(), isBetter);
+    } else if (isBetter(candidate, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), isBetter);
+        heap.back() = candidate;
+        std::push_heap(heap.begin(), heap.end(), isBetter);
+    }
+}
+
+// ==== CPU FEATURES ====
+
+#ifdef PRMS_HAVE_AVX2_GATHER
+/**
+ * @brief Whether the CPU runs the AVX2 kernels (checked once)
+ */
+inline bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+#endif // FACTOR_SUPPORT_H
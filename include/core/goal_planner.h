@@ -0,0 +1,185 @@
+/**
+ * @file goal_planner.h
+ * @brief Daily and weekly reading goals from available time (FR-026)
+ *
+ * The planner takes the time the user has for reading on each day (a
+ * weekly routine with exceptions from the calendar) and the books still
+ * to read, with their estimated minutes left (see SpeedModel), and
+ * allocates reading minutes to books so that deadlines and goals such as
+ * "finish 12 books by the end of June" are met where possible.
+ *
+ * The allocation is a greedy heuristic:
+ *
+ * - Books with a deadline, and the shortest books needed to meet each
+ *   goal (most books per minute, as in a knapsack with equal values),
+ *   come first, earliest deadline first. Earliest-deadline-first never
+ *   misses a deadline another order would meet.
+ * - The remaining books follow by priority per minute.
+ * - Days are filled in that order, each book carrying over into the next
+ *   day until it is done.
+ *
+ * The plan is kept implicitly, as the order plus two prefix sums (time
+ * available, and minutes of the books in order). Any day's allocation
+ * and any book's finish day are binary searches. A progress update only
+ * changes one book's minutes, an O(log n) update, so the plan follows
+ * the user's reading without being solved again.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef GOAL_PLANNER_H
+#define GOAL_PLANNER_H
+
+#include <vector>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+/// Finish day of a book that does not fit in the planning horizon
+constexpr int kNotScheduled = -1;
+
+/**
+ * @brief Time available for reading
+ *
+ * Days are numbered as days since the epoch (local days).
+ */
+struct ReadingCalendar {
+    std::array<double, 7> weeklyMinutes{}; // Monday first
+    std::map<std::int64_t, double> exceptions; // day -> minutes, overriding the routine
+
+    /**
+     * @brief Minutes available on a day
+     */
+    double getMinutes(std::int64_t day) const;
+};
+
+/**
+ * @brief A book to plan
+ */
+struct PlannedBook {
+    int bookId = 0;
+    double minutesLeft = 0.0; // estimated reading time left
+    std::optional<std::int64_t> deadline; // day it must be finished by
+    double priority = 1.0; // relative importance of books without a deadline
+};
+
+/**
+ * @brief "Finish this many books by this day"
+ */
+struct ReadingGoal {
+    int books = 0;
+    std::int64_t byDay = 0;
+};
+
+/**
+ * @brief Minutes planned for one book on one day
+ */
+struct PlanAllocation {
+    int bookId;
+    double minutes;
+};
+
+/**
+ * @brief Allocates reading time to books over a horizon
+ */
+class GoalPlanner {
+    public:
+        GoalPlanner();
+
+        // ==== SOLVING ====
+
+        /**
+         * @brief Plan from scratch
+         *
+         * @param calendar Time available
+         * @param books Books to plan (finished ones may be included)
+         * @param goals Goals to meet
+         * @param startDay First day of the plan (today)
+         * @param horizonDays Days to plan (366 plans a year ahead)
+         */
+        void solve(const ReadingCalendar& calendar, const std::vector<PlannedBook>& books,
+                   const std::vector<ReadingGoal>& goals, std::int64_t startDay,
+                   std::size_t horizonDays = 366);
+
+        /**
+         * @brief Record progress on a book without solving again
+         *
+         * @param bookId The book
+         * @param minutesLeft New estimate of the minutes left (0 when finished)
+         * @return False if the book is not in the plan
+         *
+         * The order is kept; call solve() when books, goals or the
+         * calendar change, or at the start of a new day.
+         */
+        bool updateProgress(int bookId, double minutesLeft);
+
+        // ==== RESULTS ====
+
+        /**
+         * @brief Reading planned for a day
+         * @param day Day (since the epoch)
+         * @return Books and minutes, in reading order
+         */
+        std::vector<PlanAllocation> getDayPlan(std::int64_t day) const;
+
+        /**
+         * @brief Minutes to read on a day (the daily goal)
+         */
+        double getDailyGoal(std::int64_t day) const;
+
+        /**
+         * @brief Minutes to read in the seven days from a day (the weekly goal)
+         */
+        double getWeeklyGoal(std::int64_t firstDay) const;
+
+        /**
+         * @brief Day a book will be finished on
+         * @return The day, or kNotScheduled if it does not fit the horizon
+         *         or is not planned
+         */
+        std::int64_t getFinishDay(int bookId) const;
+
+        /**
+         * @brief Books that will miss their deadline (including goal deadlines)
+         */
+        std::vector<int> getMissedDeadlines() const;
+
+        /**
+         * @brief Planned books in reading order
+         */
+        std::vector<int> getOrder() const;
+
+    private:
+        /**
+         * @brief Minutes of the books at positions [0, count)
+         */
+        double getBookPrefix(std::size_t count) const;
+
+        /**
+         * @brief Add minutes to the book at a position (Fenwick tree update)
+         */
+        void addBookMinutes(std::size_t position, double minutes);
+
+        /**
+         * @brief First position whose books reach past a minute mark
+         */
+        std::size_t findBookAt(double minuteMark) const;
+
+        /**
+         * @brief Plan day of a minute mark (the day whose time contains it)
+         */
+        std::int64_t findDayAt(double minuteMark) const;
+
+        std::int64_t m_startDay; // day 0 of the plan
+        std::vector<double> m_capacityPrefix; // minutes available before each plan day
+        std::vector<PlannedBook> m_order; // books in reading order, with their effective deadlines
+        std::vector<double> m_minutes; // minutes left, by position
+        std::vector<double> m_tree; // Fenwick tree over m_minutes
+        std::unordered_map<int, std::size_t> m_positions; // book ID -> position
+};
+
+#endif // GOAL_PLANNER_H
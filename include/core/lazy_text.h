@@ -0,0 +1,114 @@
+/**
+ * @file lazy_text.h
+ * @brief Lazily loaded text (reviews, notes) for Book objects
+ *
+ * Long text bodies live in side storage instead of the books row. A Book
+ * loaded from the database only carries a handle to them; the text is
+ * read the first time somebody asks for it.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef LAZY_TEXT_H
+#define LAZY_TEXT_H
+
+#include <string> // included because we need to hold the text body
+#include <optional> // included because the body may not be loaded yet
+#include <functional> // included because we need to store the loader
+#include <memory> // included because copies share the deferred body
+#include <mutex> // included because the body is loaded once across threads
+#include <atomic> // included because isLoaded() may race with the load
+
+/**
+ * @brief Kinds of long text stored outside the books table
+ */
+enum class BookTextKind : int {
+    Review = 0,
+    Notes  = 1
+};
+
+/**
+ * @brief A text value that may be loaded on first access
+ *
+ * A LazyText is either:
+ * - loaded: the text is in memory (set by the user or already read), or
+ * - deferred: only a loader is stored, and get() calls it once.
+ *
+ * A deferred LazyText that was never read is never written back, so
+ * saving a book does not need to touch its side storage.
+ *
+ * Books in a published table snapshot are read from several threads, so
+ * get() may be called concurrently: the body is loaded once, under a
+ * once flag, and shared by every copy of the deferred text. set() is a
+ * write and needs the usual exclusive access.
+ */
+class LazyText {
+    public:
+        // ==== CONSTRUCTORS ====
+
+        /**
+         * @brief Default constructor - creates an empty, loaded text
+         */
+        LazyText();
+
+        /**
+         * @brief Create a loaded text with the given body
+         * @param text The text body
+         */
+        explicit LazyText(std::string text);
+
+        /**
+         * @brief Create a deferred text
+         *
+         * @param loader Called once on first access to read the body
+         * @return A LazyText that has not been loaded yet
+         *
+         * Loaders made by Database share its connection, so the text can
+         * still be read after the Database object is gone.
+         */
+        static LazyText deferred(std::function<std::string()> loader);
+
+        // ==== ACCESS ====
+
+        /**
+         * @brief Get the text, loading it if needed
+         * @return The text body
+         */
+        const std::string& get() const;
+
+        /**
+         * @brief Replace the text
+         * @param text The new text body
+         */
+        void set(std::string text);
+
+        /**
+         * @brief Check whether the body is in memory
+         * @return True if get() will not hit the database
+         */
+        bool isLoaded() const;
+
+        /**
+         * @brief Check whether the text was changed since it was loaded
+         * @return True if set() was called
+         */
+        bool isModified() const;
+
+    private:
+        /**
+         * @brief Body of a deferred text, shared by its copies
+         */
+        struct DeferredBody {
+            std::function<std::string()> loader; // reads the body on demand
+            std::once_flag once; // guards the call to loader
+            std::atomic<bool> loaded{false}; // true once text holds the body
+            std::string text; // the body, once loaded
+        };
+
+        std::string m_text; // the body, unless deferred
+        std::shared_ptr<DeferredBody> m_deferred; // set while the body is deferred
+        bool m_modified; // true if set() was called
+};
+
+#endif // LAZY_TEXT_H
@@ -0,0 +1,236 @@
+/**
+ * @file memory_budget.h
+ * @brief Per-subsystem memory accounting and budgets
+ *
+ * Every large in-memory structure (table chunks, sort key columns, the
+ * undo history) holds MemoryCharge objects that report its heap bytes
+ * to the process-wide MemoryAccounting under a subsystem tag. Reports
+ * for the metrics panel and the command line read the totals from there.
+ *
+ * A subsystem can have a budget. When a charge pushes it over, the
+ * subsystem is flagged, and the next enforceBudgets() call runs its
+ * reclaimers: caches evict and optional structures are dropped, so the
+ * process does not grow without bound.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief The subsystems memory is accounted to
+ */
+enum class MemorySubsystem : int {
+    BookTable,   // Column data of the in-memory table
+    SortKeys,    // Collated sort key columns (can be dropped; the database keeps them)
+    EditHistory, // Undo/redo commands (oldest are evicted first)
+    Count
+};
+
+/// Number of subsystems
+constexpr std::size_t kMemorySubsystemCount = static_cast<std::size_t>(MemorySubsystem::Count);
+
+/**
+ * @brief Short name of a subsystem ("book_table", ...), as used in budget specs
+ */
+const char* getSubsystemName(MemorySubsystem subsystem);
+
+/**
+ * @brief Accounting figures of one subsystem
+ */
+struct MemoryUsage {
+    MemorySubsystem subsystem;
+    std::int64_t bytes; // currently charged
+    std::int64_t peak; // highest value of bytes so far
+    std::int64_t budget; // 0 when unlimited
+};
+
+/**
+ * @brief Process-wide memory accounting
+ *
+ * Charging is lock-free. Reclaimers run only inside enforceBudgets(),
+ * which callers invoke where they hold no locks of their own, so a
+ * reclaimer may freely call back into the subsystem it trims.
+ */
+class MemoryAccounting {
+    public:
+        /// Called with the number of bytes the subsystem is over its budget
+        using Reclaimer = std::function<void(std::int64_t excess)>;
+
+        /**
+         * @brief The process-wide instance
+         */
+        static MemoryAccounting& global();
+
+        MemoryAccounting();
+        MemoryAccounting(const MemoryAccounting&) = delete;
+        MemoryAccounting& operator=(const MemoryAccounting&) = delete;
+
+        // ==== ACCOUNTING ====
+
+        /**
+         * @brief Add (or, when negative, remove) bytes from a subsystem
+         */
+        void charge(MemorySubsystem subsystem, std::int64_t bytes);
+
+        /**
+         * @brief Bytes currently charged to a subsystem
+         */
+        std::int64_t getBytes(MemorySubsystem subsystem) const;
+
+        /**
+         * @brief Figures of every subsystem, for the metrics panel
+         */
+        std::vector<MemoryUsage> getUsage() const;
+
+        /**
+         * @brief Format the figures as a text table, for the command line
+         */
+        std::string formatReport() const;
+
+        // ==== BUDGETS ====
+
+        /**
+         * @brief Set the budget of a subsystem
+         * @param subsystem The subsystem
+         * @param bytes The budget (0 for unlimited)
+         */
+        void setBudget(MemorySubsystem subsystem, std::int64_t bytes);
+
+        /**
+         * @brief Set budgets from a spec such as "book_table=512M,sort_keys=64M"
+         *
+         * @param spec Comma separated name=size pairs; sizes take an
+         *             optional K, M or G suffix
+         * @throws std::invalid_argument on unknown names or bad sizes
+         */
+        void setBudgets(const std::string& spec);
+
+        /**
+         * @brief Get the budget of a subsystem (0 when unlimited)
+         */
+        std::int64_t getBudget(MemorySubsystem subsystem) const;
+
+        /**
+         * @brief Check whether a subsystem is over its budget
+         */
+        bool isOverBudget(MemorySubsystem subsystem) const;
+
+        /**
+         * @brief Register a reclaimer for a subsystem
+         *
+         * @param subsystem The subsystem it frees memory of
+         * @param reclaimer Called by enforceBudgets() while over budget
+         * @return Handle for removeReclaimer()
+         */
+        int addReclaimer(MemorySubsystem subsystem, Reclaimer reclaimer);
+
+        /**
+         * @brief Unregister a reclaimer
+         *
+         * Waits for a running enforceBudgets(), so the reclaimer is never
+         * called once this returns. Must not be called from a reclaimer.
+         */
+        void removeReclaimer(int handle);
+
+        /**
+         * @brief Run the reclaimers of subsystems that went over budget
+         *
+         * Cheap when nothing went over budget since the last call. Must
+         * be called without holding locks a reclaimer may take.
+         */
+        void enforceBudgets();
+
+    private:
+        struct Registration {
+            int handle;
+            MemorySubsystem subsystem;
+            Reclaimer reclaimer;
+        };
+
+        std::array<std::atomic<std::int64_t>, kMemorySubsystemCount> m_bytes;
+        std::array<std::atomic<std::int64_t>, kMemorySubsystemCount> m_peaks;
+        std::array<std::atomic<std::int64_t>, kMemorySubsystemCount> m_budgets;
+        std::atomic<bool> m_pending; // a subsystem went over budget since the last enforcement
+        std::mutex m_reclaimMutex; // guards the registrations and serializes enforcement
+        std::vector<Registration> m_reclaimers;
+        int m_nextHandle;
+};
+
+/**
+ * @brief Bytes held by one subsystem on behalf of one object
+ *
+ * Charges the process-wide accounting while alive. Copies charge the
+ * same amount again (the copy owns its own memory); moves transfer it.
+ */
+class MemoryCharge {
+    public:
+        /**
+         * @brief Constructor - charges bytes to a subsystem
+         */
+        explicit MemoryCharge(MemorySubsystem subsystem, std::int64_t bytes = 0);
+        MemoryCharge(const MemoryCharge& other);
+        MemoryCharge(MemoryCharge&& other) noexcept;
+        MemoryCharge& operator=(const MemoryCharge& other);
+        MemoryCharge& operator=(MemoryCharge&& other) noexcept;
+
+        /**
+         * @brief Destructor - releases the charge
+         */
+        ~MemoryCharge();
+
+        /**
+         * @brief Change the charged amount
+         */
+        void set(std::int64_t bytes);
+
+        /**
+         * @brief Get the charged amount
+         */
+        std::int64_t get() const;
+
+    private:
+        MemorySubsystem m_subsystem; // where the bytes are accounted
+        std::int64_t m_bytes; // currently charged
+};
+
+// ==== SIZE ESTIMATES ====
+
+/**
+ * @brief Heap bytes of a string (0 when it fits the small-string buffer)
+ */
+inline std::size_t heapBytes(const std::string& text) {
+    return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+}
+
+/**
+ * @brief Heap bytes of a vector of plain values
+ */
+template <typename T>
+std::size_t heapBytes(const std::vector<T>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+/**
+ * @brief Heap bytes of a vector of strings, including their buffers
+ */
+inline std::size_t heapBytes(const std::vector<std::string>& values) {
+    std::size_t bytes = values.capacity() * sizeof(std::string);
+    for (const std::string& value : values) {
+        bytes += heapBytes(value);
+    }
+    return bytes;
+}
+
+#endif // MEMORY_BUDGET_H
@@ -0,0 +1,45 @@
+/**
+ * @file parallel.h
+ * @brief Minimal fork-join helper for scans over BookTable chunks
+ *
+ * Chunks are independent and immutable once published, so analytics can
+ * scan them on several threads with no locking. Each worker gets its own
+ * index so callers can keep per-worker partial results and merge them
+ * afterwards.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+/// Fewer tasks than this run on the calling thread
+constexpr std::size_t kMinParallelTasks = 4;
+
+/**
+ * @brief Number of workers parallelFor() will use for a task count
+ *
+ * @param taskCount Number of tasks
+ * @return At least 1, at most the hardware thread count and taskCount
+ */
+std::size_t getWorkerCount(std::size_t taskCount);
+
+/**
+ * @brief Run body(worker, task) for every task in [0, taskCount)
+ *
+ * @param taskCount Number of tasks
+ * @param body Called once per task; worker is in [0, getWorkerCount())
+ *
+ * Tasks are handed out dynamically so slow chunks don't stall the rest.
+ * Returns when every task is done, also when fewer threads than
+ * workers could be started. The first exception thrown by body is
+ * rethrown on the calling thread.
+ */
+void parallelFor(std::size_t taskCount,
+                 const std::function<void(std::size_t worker, std::size_t task)>& body);
+
+#endif // PARALLEL_H
@@ -0,0 +1,138 @@
+/**
+ * @file quantized_factors.h
+ * @brief Product-quantized item factors for compact recommendation scoring (NFR-014)
+ *
+ * A float factor file for a 1M-book catalog at rank 32 is 128 MB, and
+ * scoring it reads all of it. Product quantization splits every vector
+ * into subspaces of a few dimensions and stores, per subspace, the index
+ * of the nearest of 256 centroids learned by k-means: one byte replaces
+ * subspaceDims floats, a 4x (1 dimension), 8x (2) or 16x (4) reduction.
+ *
+ * Scoring is asymmetric: the profile stays exact. For each subspace the
+ * dot products of the profile with all 256 centroids are computed once,
+ * and an item's approximate score is the sum of one table entry per
+ * subspace, looked up by its codes (with AVX2 gathers when available).
+ * The best candidates are then re-ranked with their full-precision
+ * vectors from the FactorFile, which is memory-mapped, so only the pages
+ * of those few candidates are ever read.
+ *
+ * File layout (little-endian, items in the order of the factor file):
+ *
+ *     header     QuantizedFactorsHeader
+ *     codebook   subspaceCount * 256 * subspaceDims floats
+ *     codes      itemCount * subspaceCount bytes, then 4 bytes of padding
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef QUANTIZED_FACTORS_H
+#define QUANTIZED_FACTORS_H
+
+#include "factor_file.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// Identifies quantized factor files (and their version)
+constexpr char kQuantizedFactorsMagic[8] = { 'P', 'R', 'M', 'S', 'P', 'Q', '0', '1' };
+
+/// Centroids per subspace (one byte per code)
+constexpr std::size_t kCentroidCount = 256;
+
+/// Approximate candidates re-ranked per requested item (16x codes need a deep re-rank)
+constexpr std::size_t kDefaultRerankFactor = 64;
+
+/**
+ * @brief Fixed-size start of a quantized factor file
+ */
+struct QuantizedFactorsHeader {
+    char magic[8];
+    std::uint32_t rank;
+    std::uint32_t subspaceDims; // dimensions per code
+    std::uint64_t itemCount;
+    std::uint64_t codebookOffset;
+    std::uint64_t codesOffset;
+    std::uint64_t fileSize;
+};
+
+/**
+ * @brief Quantize a factor file and write the result atomically
+ *
+ * @param path Destination
+ * @param factors The full-precision factors
+ * @param subspaceDims Dimensions per code; must divide the rank
+ * @param iterations k-means iterations per subspace
+ * @param seed Seeds the sample and the initial centroids
+ * @return False if subspaceDims does not divide the rank or writing failed
+ */
+bool writeQuantizedFactors(const std::string& path, const FactorFile& factors, std::uint32_t subspaceDims,
+                           int iterations = 10, std::uint64_t seed = 1);
+
+/**
+ * @brief A quantized factor file mapped into memory (read-only)
+ */
+class QuantizedFactors {
+    public:
+        /**
+         * @brief Constructor - maps a quantized factor file
+         * @param path The file
+         * @throws std::runtime_error if it cannot be mapped or is malformed
+         */
+        explicit QuantizedFactors(const std::string& path);
+
+        /**
+         * @brief Destructor - unmaps the file
+         */
+        ~QuantizedFactors();
+
+        QuantizedFactors(const QuantizedFactors&) = delete;
+        QuantizedFactors& operator=(const QuantizedFactors&) = delete;
+
+        std::uint32_t getRank() const;
+        std::size_t getItemCount() const;
+        std::uint32_t getSubspaceDims() const;
+        std::size_t getSubspaceCount() const;
+
+        /**
+         * @brief Codes of an item (getSubspaceCount() bytes)
+         */
+        const std::uint8_t* getCodes(std::size_t item) const;
+
+        /**
+         * @brief Centroids of a subspace (kCentroidCount * getSubspaceDims() floats)
+         */
+        const float* getCodebook(std::size_t subspace) const;
+
+        /**
+         * @brief Decode an item's approximate vector
+         */
+        std::vector<float> decode(std::size_t item) const;
+
+    private:
+        void* m_data; // the mapping
+        std::size_t m_size; // its length
+        const QuantizedFactorsHeader* m_header;
+        const float* m_codebook;
+        const std::uint8_t* m_codes;
+};
+
+/**
+ * @brief Best items for a profile, scored on the quantized codes
+ *
+ * @param codes The quantized catalog
+ * @param factors The full-precision catalog it was built from
+ * @param profile The taste vector (see buildProfile())
+ * @param k How many items to return
+ * @param exclude Items not to recommend
+ * @param rerankFactor k * rerankFactor candidates are re-ranked exactly
+ * @return Up to k items, best first, with exact scores; empty if the two
+ *         files do not describe the same catalog
+ */
+std::vector<ItemScore> scoreItemsQuantized(const QuantizedFactors& codes, const FactorFile& factors,
+                                           const std::vector<float>& profile, std::size_t k,
+                                           const std::vector<std::uint32_t>& exclude = {},
+                                           std::size_t rerankFactor = kDefaultRerankFactor);
+
+#endif // QUANTIZED_FACTORS_H
@@ -0,0 +1,43 @@
+/**
+ * @file reading_event.h
+ * @brief Reading activity reported by external trackers (e-readers)
+ *
+ * A ReadingEvent says "at this time, the user was on this page of this
+ * book". Events arrive as lines in activity logs and are applied to the
+ * collection as progress updates.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef READING_EVENT_H
+#define READING_EVENT_H
+
+#include <string> // included because we parse events from text lines
+#include <chrono> // included because every event has a timestamp
+#include <optional> // included because a line may not hold a valid event
+
+/**
+ * @brief A single progress report from a reading tracker
+ */
+struct ReadingEvent {
+    int bookId = 0; // book the user was reading
+    int page = 0; // page the user reached
+    std::chrono::system_clock::time_point timestamp; // when the page was reached
+};
+
+/**
+ * @brief Parse one line of an activity log
+ *
+ * @param line A line without its trailing newline
+ * @return The event, or empty if the line is blank, a comment or malformed
+ *
+ * The expected format is three whitespace separated fields:
+ *
+ *     <unix seconds> <book id> <page>
+ *
+ * Lines starting with '#' are comments.
+ */
+std::optional<ReadingEvent> parseReadingEvent(const std::string& line);
+
+#endif // READING_EVENT_H
@@ -0,0 +1,166 @@
+/**
+ * @file reading_log_tailer.h
+ * @brief Streams reading activity from e-reader logs into the database
+ *
+ * E-reader sync tools append one line per reading event to a log file.
+ * The ReadingLogTailer follows such a file like `tail -F`: it reads new
+ * lines as they are written, applies them as progress updates and
+ * remembers how far it got, so nothing is applied twice after a restart.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef READING_LOG_TAILER_H
+#define READING_LOG_TAILER_H
+
+#include "reading_event.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+class Database;
+
+/**
+ * @brief Follows an activity log and applies new lines as they appear
+ *
+ * Each batch of new complete lines is applied in a single transaction
+ * together with the new file offset, so the checkpoint never gets ahead
+ * of (or falls behind) the applied progress.
+ *
+ * On Linux the tailer sleeps on inotify and wakes as soon as the log is
+ * written, keeping write-to-dashboard latency well under a second. On
+ * other platforms it polls.
+ *
+ * Rotation is detected by inode: when the path points to a new file the
+ * rest of the old file is drained first, then the new one is read from
+ * the start. A file that shrinks in place (truncation) is re-read from
+ * the start.
+ */
+class ReadingLogTailer {
+    public:
+        /**
+         * @brief Called after a batch was committed
+         *
+         * Runs on the tailer thread. GUI code must forward the events to
+         * the UI thread (for example with a queued Qt signal).
+         */
+        using Listener = std::function<void(const std::vector<ReadingEvent>& events)>;
+
+        // ==== CONSTRUCTOR and DESTRUCTOR ====
+
+        /**
+         * @brief Constructor - prepares a tailer, does not start it
+         *
+         * @param dbPath Path of the database to apply events to. The
+         *               tailer opens its own connection so that it never
+         *               shares one with the GUI thread.
+         * @param logPath Path of the activity log to follow
+         */
+        ReadingLogTailer(const std::string& dbPath, const std::string& logPath);
+
+        /**
+         * @brief Destructor - stops the tailer thread
+         */
+        ~ReadingLogTailer();
+
+        ReadingLogTailer(const ReadingLogTailer&) = delete;
+        ReadingLogTailer& operator=(const ReadingLogTailer&) = delete;
+
+        // ==== CONTROL ====
+
+        /**
+         * @brief Set the function called after each applied batch
+         * @param listener The callback (must be set before start())
+         */
+        void setListener(Listener listener);
+
+        /**
+         * @brief Start following the log on a background thread
+         *
+         * Resumes from the stored checkpoint if the log file is still the
+         * same one; otherwise starts at the beginning of the current file.
+         *
+         * @throws std::runtime_error if the database cannot be opened
+         */
+        void start();
+
+        /**
+         * @brief Stop following the log and wait for the thread to exit
+         */
+        void stop();
+
+        /**
+         * @brief Check whether the tailer thread is running
+         * @return True between start() and stop()
+         */
+        bool isRunning() const;
+
+        /**
+         * @brief Read and apply everything written since the last call
+         *
+         * @return Number of events applied
+         *
+         * This is what the background thread runs after every wake-up. It
+         * can also be called directly (without start()) for one-shot
+         * imports.
+         */
+        int processNewLines();
+
+        /**
+         * @brief Number of lines skipped because they could not be parsed
+         */
+        std::uint64_t getSkippedLineCount() const;
+
+    private:
+        // ==== HELPER METHODS ====
+
+        /**
+         * @brief Open the database and restore the checkpoint
+         */
+        void openDatabase();
+
+        /**
+         * @brief Open the log file, resuming from the checkpoint if valid
+         * @return True if the file is open
+         */
+        bool openLog();
+
+        /**
+         * @brief Read the open log to its end and apply complete lines
+         * @return Number of events applied
+         */
+        int drainLog();
+
+        /**
+         * @brief Close the log file
+         */
+        void closeLog();
+
+        /**
+         * @brief Body of the background thread
+         */
+        void run();
+
+        // ==== MEMBER VARIABLES ====
+
+        std::string m_dbPath; // database the events are applied to
+        std::string m_logPath; // activity log being followed
+        std::unique_ptr<Database> m_database; // connection owned by the tailer
+        Listener m_listener; // called after each committed batch
+
+        int m_fd; // open log file descriptor, -1 if none
+        std::uint64_t m_inode; // inode of the open log file
+        std::int64_t m_readOffset; // bytes read from the open log file
+        std::string m_pending; // trailing partial line, not applied yet
+        std::atomic<std::uint64_t> m_skippedLines; // lines that failed to parse
+
+        std::thread m_thread; // background tailing thread
+        std::atomic<bool> m_running; // cleared to ask the thread to stop
+};
+
+#endif // READING_LOG_TAILER_H
@@ -0,0 +1,111 @@
+/**
+ * @file recommender.h
+ * @brief Recommendations kept up to date incrementally as books are completed (FR-041)
+ *
+ * Scoring the whole catalog (see scoreItems()) after every
+ * markAsCompleted() would rescan millions of vectors for one book. The
+ * Recommender scans once, in rebuild(), and keeps a bounded pool of the
+ * best candidates. The profile is the mean of the completed items'
+ * vectors, so it is kept as a sum and a count: completing a book adds
+ * one vector (O(rank)), and only the pool is rescored (O(pool * rank)).
+ * "Because you finished X" suggestions come from the same pool, ranked
+ * by their affinity with X's vector, so they are ready at once.
+ *
+ * An item outside the pool scored at most the pool's threshold at the
+ * last rebuild, and its score can only have grown by |profile change| *
+ * (largest vector norm). While the pool's k-th score stays above that
+ * bound, its top k is exactly the catalog's; needsRebuild() says when
+ * it is not, and the caller schedules a full rebuild in the background.
+ *
+ * The Recommender is not thread-safe; use one per thread or lock.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef RECOMMENDER_H
+#define RECOMMENDER_H
+
+#include "book.h"
+#include "factor_file.h"
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include <cstddef>
+
+/// Candidates kept between full rebuilds
+constexpr std::size_t kDefaultCandidatePool = 500;
+
+/**
+ * @brief Keeps recommendations current as books are completed
+ */
+class Recommender {
+    public:
+        /**
+         * @brief Constructor
+         * @param factors The catalog; must outlive the Recommender
+         * @param poolSize Candidates kept between rebuilds
+         */
+        explicit Recommender(const FactorFile& factors, std::size_t poolSize = kDefaultCandidatePool);
+
+        /**
+         * @brief Recompute everything from the user's books (scans the catalog)
+         * @param history The user's books; the completed ones form the profile
+         */
+        void rebuild(const std::vector<Book>& history);
+
+        /**
+         * @brief Account for a newly completed book (no catalog scan)
+         *
+         * Call after Book::markAsCompleted() or a bulk edit completing it.
+         *
+         * @param book The completed book
+         * @return False if it is not in the catalog or was already counted
+         */
+        bool addCompleted(const Book& book);
+
+        /**
+         * @brief The best items for the current profile
+         * @param k How many (at most the pool size)
+         * @return Best first; empty while no completed book is in the catalog
+         */
+        std::vector<ItemScore> getRecommendations(std::size_t k) const;
+
+        /**
+         * @brief "Because you finished X" suggestions
+         *
+         * @param book The finished book
+         * @param k How many
+         * @return Pool items ranked by their dot product with the book's
+         *         vector, best first; empty if it is not in the catalog
+         */
+        std::vector<ItemScore> getBecauseYouFinished(const Book& book, std::size_t k) const;
+
+        /**
+         * @brief Whether the pool can no longer vouch for the top k
+         */
+        bool needsRebuild(std::size_t k) const;
+
+        /**
+         * @brief Completed books found in the catalog
+         */
+        std::size_t getCompletedCount() const;
+
+    private:
+        const FactorFile& m_factors;
+        std::size_t m_poolSize;
+        float m_maxNorm; // largest vector norm in the catalog
+        std::unordered_set<std::uint32_t> m_completed;
+        std::vector<double> m_profileSum; // sum of the completed items' vectors
+        std::vector<float> m_profile; // m_profileSum / completed count
+        std::vector<float> m_rebuildProfile; // profile at the last rebuild
+        std::vector<ItemScore> m_pool; // best first
+        float m_threshold; // no item outside the pool scored above this at the last rebuild
+        bool m_poolComplete; // the pool held every item not completed at the last rebuild
+
+        void updateProfile();
+        void rescorePool();
+};
+
+#endif // RECOMMENDER_H
@@ -0,0 +1,79 @@
+/**
+ * @file sort_key.h
+ * @brief Locale-aware binary sort keys for titles and authors
+ *
+ * Comparing two strings with a locale's collation rules is expensive,
+ * and a sort does it O(n log n) times. Instead, every title and author
+ * is transformed once into a binary sort key: comparing two keys with
+ * memcmp gives the same order as collating the original strings. The
+ * keys are kept in the BookTable columns and in the book_sort_keys
+ * table, so both in-memory sorts and SQL ORDER BY use them.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef SORT_KEY_H
+#define SORT_KEY_H
+
+#include "book_table.h"
+#include <string>
+#include <locale>
+#include <vector>
+
+/**
+ * @brief Orders that use the collated sort keys
+ */
+enum class CollatedOrder {
+    Title,       // Title, then author
+    AuthorTitle  // Author, then title
+};
+
+/**
+ * @brief Turns strings into binary sort keys for one locale
+ *
+ * Immutable after construction and safe to share between threads.
+ */
+class SortKeyGenerator {
+    public:
+        /**
+         * @brief Constructor - loads the collation rules of a locale
+         *
+         * @param localeName A locale name such as "en_US.UTF-8" ("" uses
+         *                   the user's environment)
+         * @throws std::runtime_error if the locale is not available
+         */
+        explicit SortKeyGenerator(const std::string& localeName);
+
+        /**
+         * @brief Get the name of the locale the keys are generated for
+         */
+        const std::string& getLocaleName() const;
+
+        /**
+         * @brief Build the sort key of a string
+         *
+         * @param text The string (title or author)
+         * @return Bytes that compare with memcmp (shorter first on a tie)
+         *         like text compares under the locale's collation
+         */
+        std::string makeKey(const std::string& text) const;
+
+    private:
+        std::string m_localeName; // name the keys are tagged with
+        std::locale m_locale; // locale holding the collate facet
+};
+
+/**
+ * @brief Sort the books of a snapshot by their collated sort keys
+ *
+ * @param snapshot The snapshot to order
+ * @param order Which keys to sort by
+ * @return Every row of the snapshot in sorted order
+ *
+ * Ties are broken by book ID. Chunks built without a SortKeyGenerator
+ * fall back to plain byte order of the strings.
+ */
+std::vector<SnapshotRow> collatedOrder(const BookTableSnapshot& snapshot, CollatedOrder order);
+
+#endif // SORT_KEY_H
@@ -0,0 +1,168 @@
+/**
+ * @file speed_model.h
+ * @brief Reading speed calibrated by genre, difficulty and time of day (FR-020, FR-022)
+ *
+ * How fast the user reads depends on what and when: dense non-fiction
+ * in the evening goes slower than a thriller in the morning. The
+ * SpeedModel learns words per minute from speed tests and keeps the
+ * result as a dense lookup table indexed by
+ *
+ *     (genre, difficulty bucket, time-of-day bucket)
+ *
+ * Estimating the reading time of the whole to-be-read pile is then one
+ * table lookup and one division per book. The lookups run as vector
+ * gathers where the CPU has them (AVX2), so re-estimating a large pile
+ * after a speed test takes microseconds.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef SPEED_MODEL_H
+#define SPEED_MODEL_H
+
+#include "book_table.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/// Difficulty buckets, from 0 (light) to 4 (dense)
+constexpr std::size_t kDifficultyBuckets = 5;
+
+/// Time-of-day buckets of four hours each (0 is midnight to 4 am)
+constexpr std::size_t kTimeOfDayBuckets = 6;
+
+/// Difficulty assumed when nothing better is known
+constexpr int kDefaultDifficulty = 2;
+
+/// Words on a typical printed page
+constexpr double kDefaultWordsPerPage = 275.0;
+
+/**
+ * @brief The result of one timed reading
+ */
+struct SpeedTest {
+    std::string genre; // genre of the text read
+    int difficulty = kDefaultDifficulty; // bucket of the text
+    std::chrono::system_clock::time_point time; // when the test was taken
+    std::int64_t words = 0; // words read
+    double minutes = 0.0; // time taken
+};
+
+/**
+ * @brief Books whose reading time is estimated, in column form
+ *
+ * Each book's genre and difficulty are resolved to a table cell once,
+ * so an estimate only adds the time-of-day bucket.
+ */
+struct SpeedCandidates {
+    std::vector<int> bookIds;
+    std::vector<std::int32_t> cells; // table index without the time-of-day bucket
+    std::vector<float> words; // words left to read
+};
+
+/**
+ * @brief Calibrated words-per-minute model
+ *
+ * Internally the speed is a product of factors (a base speed and one
+ * factor each for genre, difficulty and time of day), learned in log
+ * space from speed tests. The dense table is rebuilt from the factors
+ * after every test.
+ */
+class SpeedModel {
+    public:
+        /**
+         * @brief Constructor - an uncalibrated model
+         * @param baseWpm Speed assumed before any test
+         * @param utcOffsetSeconds Local time zone offset, for time-of-day buckets
+         */
+        explicit SpeedModel(double baseWpm = 250.0, std::int64_t utcOffsetSeconds = 0);
+
+        // ==== CALIBRATION ====
+
+        /**
+         * @brief Fold a speed test into the model and rebuild the table
+         * @param test The test (ignored if it has no words or no time)
+         */
+        void recordSpeedTest(const SpeedTest& test);
+
+        /**
+         * @brief Number of speed tests folded in
+         */
+        std::size_t getTestCount() const;
+
+        // ==== LOOKUP ====
+
+        /**
+         * @brief Row of a genre in the table, adding it if new
+         *
+         * Genres without tests use the base speed until they get one.
+         */
+        int addGenre(const std::string& genre);
+
+        /**
+         * @brief Time-of-day bucket of a time
+         */
+        int getTimeOfDayBucket(std::chrono::system_clock::time_point time) const;
+
+        /**
+         * @brief Table cell of a genre and difficulty, without the time of day
+         */
+        static std::int32_t getCell(int genreRow, int difficulty);
+
+        /**
+         * @brief Calibrated speed
+         * @return Words per minute
+         */
+        float getWpm(const std::string& genre, int difficulty, int timeOfDay) const;
+
+        /**
+         * @brief The dense table, (genre * kDifficultyBuckets + difficulty) * kTimeOfDayBuckets + time
+         */
+        const std::vector<float>& getTable() const;
+
+    private:
+        /**
+         * @brief Recompute every cell from the factors
+         */
+        void rebuildTable();
+
+        double m_logBase; // log of the base words per minute
+        std::vector<double> m_logGenre; // per table row
+        double m_logDifficulty[kDifficultyBuckets];
+        double m_logTimeOfDay[kTimeOfDayBuckets];
+        std::unordered_map<std::string, int> m_genreRows;
+        std::vector<float> m_table;
+        std::int64_t m_utcOffsetSeconds;
+        std::size_t m_tests;
+};
+
+/**
+ * @brief Collect the books still to read from a snapshot
+ *
+ * @param snapshot The books
+ * @param model Resolves genres to table rows (new genres are added)
+ * @param difficultyOf Difficulty bucket of a book ID (empty: the default)
+ * @param wordsPerPage Words assumed per page
+ * @return Every book not completed, with the words left to read
+ */
+SpeedCandidates collectSpeedCandidates(const BookTableSnapshot& snapshot, SpeedModel& model,
+                                       const std::function<int(int bookId)>& difficultyOf = nullptr,
+                                       double wordsPerPage = kDefaultWordsPerPage);
+
+/**
+ * @brief Estimate the reading time of every candidate
+ *
+ * @param model The calibrated model
+ * @param candidates The books (collected with this model)
+ * @param timeOfDay Time-of-day bucket the user reads in
+ * @param minutes Receives one estimate per candidate
+ */
+void estimateReadingMinutes(const SpeedModel& model, const SpeedCandidates& candidates,
+                            int timeOfDay, std::vector<float>& minutes);
+
+#endif // SPEED_MODEL_H
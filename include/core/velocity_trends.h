@@ -0,0 +1,243 @@
+/**
+ * @file velocity_trends.h
+ * @brief Reading-velocity trends kept up to date session by session (FR-030)
+ *
+ * The velocity charts show how fast and how much the user reads, overall
+ * and per genre. Re-aggregating the whole reading history for every
+ * redraw gets slower as the history grows. Instead each series keeps a
+ * small model that every reading session updates incrementally:
+ *
+ * - an exponentially weighted moving average of reading speed (pages
+ *   per hour), and
+ * - Holt-Winters smoothing of pages read per day: a level, a trend and a
+ *   weekly seasonal profile (weekends usually differ from weekdays).
+ *
+ * A session on the day after the last one costs O(1). After a break of
+ * n idle days it costs O(min(n, historyDays) + log n): only the idle
+ * days kept for the trend line are closed one by one.
+ *
+ * Trend lines and forecasts are read straight from the model state.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef VELOCITY_TRENDS_H
+#define VELOCITY_TRENDS_H
+
+#include "reading_event.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/// Length of the seasonal cycle in days
+constexpr std::size_t kVelocitySeasonDays = 7;
+
+/**
+ * @brief Smoothing factors (each in (0, 1]; higher reacts faster)
+ */
+struct VelocityParameters {
+    double speedAlpha = 0.2; // EWMA of session speed
+    double levelAlpha = 0.3; // Holt-Winters level
+    double trendBeta = 0.05; // Holt-Winters trend
+    double seasonGamma = 0.2; // Holt-Winters weekly profile
+    std::int64_t utcOffsetSeconds = 0; // where days start (local time zone offset)
+    std::size_t historyDays = 365; // smoothed days kept for trend lines
+};
+
+/**
+ * @brief One stretch of reading
+ */
+struct ReadingSession {
+    std::string genre; // genre of the book read (may be empty)
+    std::chrono::system_clock::time_point end; // when the session ended
+    int pages = 0; // pages read
+    double minutes = 0.0; // time spent (0 if unknown: counts towards pages per day only)
+};
+
+/**
+ * @brief A point of a trend line or forecast
+ */
+struct VelocityPoint {
+    std::chrono::system_clock::time_point day; // start of the day
+    double pagesPerDay; // smoothed (history) or predicted (forecast) value
+};
+
+/**
+ * @brief The model of one series (overall, or one genre)
+ */
+class VelocitySeries {
+    public:
+        explicit VelocitySeries(const VelocityParameters& parameters = VelocityParameters());
+
+        /**
+         * @brief Fold a session into the model
+         *
+         * @param day Day index of the session (days since the epoch)
+         * @param pages Pages read
+         * @param minutes Time spent (0 if unknown)
+         *
+         * Days are closed (and the Holt-Winters state updated) when a
+         * later day is seen; sessions of an already closed day count
+         * towards the open one.
+         */
+        void addSession(std::int64_t day, int pages, double minutes);
+
+        /**
+         * @brief Close every day before the given one
+         *
+         * Lets idle days (no sessions) pull the model down before a
+         * chart is drawn. Idle days older than the history are applied
+         * in closed form, so a long break costs O(historyDays + log n).
+         */
+        void advanceTo(std::int64_t day);
+
+        /**
+         * @brief Smoothed reading speed in pages per hour (0 if unknown)
+         */
+        double getPagesPerHour() const;
+
+        /**
+         * @brief Deseasonalized pages per day of the last closed day
+         */
+        double getLevel() const;
+
+        /**
+         * @brief Change of the level per day
+         */
+        double getTrend() const;
+
+        /**
+         * @brief Seasonal offset of a day (pages above or below the level)
+         */
+        double getSeasonal(std::int64_t day) const;
+
+        /**
+         * @brief Pages read on the open (current) day so far
+         */
+        int getOpenDayPages() const;
+
+        /**
+         * @brief Number of sessions folded in
+         */
+        std::uint64_t getSessionCount() const;
+
+        /**
+         * @brief Smoothed level of recent closed days, oldest first
+         * @param utcOffsetSeconds Offset the day indexes were computed with
+         */
+        std::vector<VelocityPoint> getHistory(std::int64_t utcOffsetSeconds) const;
+
+        /**
+         * @brief Predicted pages per day after the last closed day
+         * @param days How many days to predict
+         * @param utcOffsetSeconds Offset the day indexes were computed with
+         */
+        std::vector<VelocityPoint> forecast(std::size_t days, std::int64_t utcOffsetSeconds) const;
+
+    private:
+        /**
+         * @brief Holt-Winters update with the total of one day
+         */
+        void closeDay(std::int64_t day, double pages);
+
+        /**
+         * @brief Apply idle days to the state without recording them
+         */
+        void skipIdleDays(std::int64_t first, std::int64_t count);
+
+        VelocityParameters m_parameters;
+        double m_pagesPerHour; // EWMA of session speed
+        bool m_hasSpeed; // a timed session was seen
+        double m_level;
+        double m_trend;
+        std::array<double, kVelocitySeasonDays> m_seasonal;
+        bool m_initialized; // a day was closed
+        std::int64_t m_openDay; // day currently accumulating (once a session was seen)
+        int m_openPages; // pages read on the open day
+        std::int64_t m_lastClosedDay;
+        std::deque<double> m_history; // levels of the most recent closed days
+        std::uint64_t m_sessions;
+};
+
+/**
+ * @brief Velocity models of the user overall and per genre
+ *
+ * Not thread-safe: feed it from one thread (the GUI thread, with the
+ * log tailer's events forwarded there).
+ */
+class VelocityTrends {
+    public:
+        explicit VelocityTrends(const VelocityParameters& parameters = VelocityParameters());
+
+        /**
+         * @brief Fold a session into the overall and the genre model
+         */
+        void addSession(const ReadingSession& session);
+
+        /**
+         * @brief Fold a progress report into the models
+         *
+         * @param event The report
+         * @param genre Genre of the book
+         *
+         * The pages since the book's previous report form a session.
+         * When the reports are close together (a sitting), the time
+         * between them is its duration; after a longer gap only the
+         * pages count. The first report of a book only sets its start.
+         */
+        void addReadingEvent(const ReadingEvent& event, const std::string& genre);
+
+        /**
+         * @brief Close every day before the given time in all models
+         */
+        void advanceTo(std::chrono::system_clock::time_point now);
+
+        /**
+         * @brief The model over all genres
+         */
+        const VelocitySeries& getOverall() const;
+
+        /**
+         * @brief The model of one genre
+         * @return The model, or nullptr if the genre has no sessions
+         */
+        const VelocitySeries* getGenre(const std::string& genre) const;
+
+        /**
+         * @brief Genres that have a model, sorted
+         */
+        std::vector<std::string> getGenres() const;
+
+        /**
+         * @brief Day index of a time (days since the epoch, local days)
+         */
+        std::int64_t toDay(std::chrono::system_clock::time_point time) const;
+
+        /**
+         * @brief Time zone offset the models use for day boundaries
+         */
+        std::int64_t getUtcOffset() const;
+
+    private:
+        /**
+         * @brief Last progress report of a book
+         */
+        struct BookProgress {
+            int page;
+            std::chrono::system_clock::time_point time;
+        };
+
+        VelocityParameters m_parameters;
+        VelocitySeries m_overall;
+        std::map<std::string, VelocitySeries> m_genres;
+        std::unordered_map<int, BookProgress> m_progress; // by book ID
+};
+
+#endif // VELOCITY_TRENDS_H
@@ -0,0 +1,110 @@
+/**
+ * @file what_if_simulator.h
+ * @brief Monte Carlo projections of goals and to-be-read completion
+ *
+ * "Will I finish 24 books this year if I read four evenings a week?"
+ * The GoalPlanner answers with one plan at average speed; real reading
+ * varies. The simulator replays the coming months many times, each time
+ * drawing whether the user reads on a day, for how long, how fast, and
+ * whether a started book is abandoned (DNF), and reports how often the
+ * goal is met and how the completion date of the pile is distributed.
+ *
+ * Runs are split into batches, each with its own seed derived from the
+ * input seed, and the batches run on all cores. The result depends
+ * only on the inputs, not on the number of threads. Partial results are
+ * reported after each round of batches, so the UI can show the
+ * estimate settling while the rest is computed. The last result is
+ * cached until the inputs change.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#ifndef WHAT_IF_SIMULATOR_H
+#define WHAT_IF_SIMULATOR_H
+
+#include "goal_planner.h"
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Everything a simulation depends on
+ */
+struct SimulationInputs {
+    std::vector<int> bookIds; // the pile, in reading order
+    std::vector<double> bookMinutes; // minutes left per book at the usual speed
+    double sessionsPerWeek = 4.0; // how often the user reads
+    double sessionMinutes = 40.0; // mean length of a session
+    double sessionMinutesSpread = 0.5; // log-normal sigma of the session length
+    double speedSpread = 0.15; // log-normal sigma of the speed of a session
+    double dnfRate = 0.1; // share of started books that are abandoned
+    ReadingGoal goal; // books to finish by a day (books 0: no goal)
+    std::int64_t startDay = 0; // first simulated day (since the epoch)
+    std::size_t horizonDays = 366;
+    std::size_t runs = 10000;
+    std::uint64_t seed = 1;
+
+    bool operator==(const SimulationInputs& other) const;
+    bool operator!=(const SimulationInputs& other) const;
+};
+
+/**
+ * @brief Aggregated outcome of the runs done so far
+ */
+struct SimulationResult {
+    std::size_t runs = 0; // runs aggregated
+    bool complete = false; // all requested runs are in
+    double goalProbability = 0.0; // share of runs meeting the goal
+    std::vector<double> completionByDay; // share of runs with the pile done by each day
+    std::int64_t completionP10 = kNotScheduled; // day the pile is done in 10% of runs
+    std::int64_t completionP50 = kNotScheduled; // median
+    std::int64_t completionP90 = kNotScheduled;
+    std::vector<double> bookFinishProbability; // per book: finished (not abandoned) within the horizon
+    std::vector<double> bookMeanFinishDay; // per book: mean finish day when finished (-1 if never)
+};
+
+/**
+ * @brief Runs what-if simulations and caches the last result
+ */
+class WhatIfSimulator {
+    public:
+        /**
+         * @brief Receives partial results on the calling thread
+         * @return False to cancel the simulation
+         */
+        using ProgressCallback = std::function<bool(const SimulationResult& partial)>;
+
+        WhatIfSimulator();
+
+        /**
+         * @brief Simulate, or return the cached result for the same inputs
+         *
+         * @param inputs What to simulate
+         * @param progress Called after each round of batches (may be empty)
+         * @return The result; incomplete if the callback cancelled
+         *
+         * Only complete results are cached.
+         */
+        SimulationResult run(const SimulationInputs& inputs, const ProgressCallback& progress = nullptr);
+
+        /**
+         * @brief The cached result, if it was computed for these inputs
+         */
+        std::optional<SimulationResult> getCached(const SimulationInputs& inputs) const;
+
+        /**
+         * @brief Forget the cached result
+         */
+        void invalidate();
+
+    private:
+        mutable std::mutex m_mutex; // guards the cache
+        std::optional<SimulationInputs> m_cachedInputs;
+        SimulationResult m_cachedResult;
+};
+
+#endif // WHAT_IF_SIMULATOR_H
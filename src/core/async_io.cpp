@@ -0,0 +1,615 @@
+/**
+ * @file async_io.cpp
+ * @brief Implementation of the asynchronous file I/O for the Personal Reading Management System (PRMS)
+ *
+ * The io_uring code talks to the kernel directly (no liburing), so the
+ * only build requirement is the kernel header.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "async_io.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define PRMS_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace {
+
+/// Worker threads of the fallback pool (enough to keep an SSD queue busy)
+constexpr std::size_t kIoWorkerThreads = 8;
+
+/// Largest transfer in one ring request (the kernel takes 32-bit lengths)
+constexpr std::size_t kMaxRingTransfer = std::size_t(1) << 30;
+
+/// user_data of the no-op that wakes the completion thread on shutdown
+constexpr std::uint64_t kWakeTag = ~std::uint64_t(0);
+
+/**
+ * @brief Results of one helper batch
+ *
+ * Shared with the callbacks, which may run on an executor after the
+ * helper's own bookkeeping.
+ */
+struct BatchResults {
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t remaining = 0;
+    std::vector<std::int64_t> results;
+
+    explicit BatchResults(std::size_t count)
+        : results(count, -1)
+    {
+    }
+
+    /**
+     * @brief Callback recording the result of request i
+     */
+    std::function<void(std::int64_t)> recorder(const std::shared_ptr<BatchResults>& self, std::size_t i) {
+        ++remaining;
+        return [self, i](std::int64_t result) {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            self->results[i] = result;
+            if (--self->remaining == 0) {
+                self->done.notify_all();
+            }
+        };
+    }
+
+    /**
+     * @brief Wait for every recorded request
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return remaining == 0; });
+    }
+};
+
+} // namespace
+
+// ==== IO_URING STATE ====
+
+/**
+ * @brief The mapped rings and the per-slot bookkeeping
+ *
+ * Each request in flight owns a slot; its index is the user_data of the
+ * submission, so completions find their request without a lookup.
+ */
+struct AsyncIo::Ring {
+    struct Slot {
+        IoRequest request;
+        std::size_t done = 0; // bytes transferred by earlier partial completions
+    };
+
+    int fd = -1;
+    unsigned entries = 0;
+    void* sqRing = nullptr;
+    std::size_t sqRingSize = 0;
+    void* cqRing = nullptr;
+    std::size_t cqRingSize = 0;
+    void* sqeMemory = nullptr;
+    std::size_t sqeMemorySize = 0;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    std::vector<Slot> slots;
+    std::vector<unsigned> freeSlots;
+    unsigned pendingSubmissions = 0; // SQEs written but not yet entered
+    bool buffersRegistered = false;
+
+#ifdef PRMS_HAVE_IO_URING
+    io_uring_sqe* sqes = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    ~Ring() {
+        if (sqeMemory) {
+            ::munmap(sqeMemory, sqeMemorySize);
+        }
+        if (cqRing && cqRing != sqRing) {
+            ::munmap(cqRing, cqRingSize);
+        }
+        if (sqRing) {
+            ::munmap(sqRing, sqRingSize);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    /**
+     * @brief Create and map a ring
+     * @return The ring, or null if io_uring is unavailable
+     */
+    static std::unique_ptr<Ring> open(unsigned depth) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        const int ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, depth, &params));
+        if (ringFd < 0) {
+            return nullptr; // ENOSYS on old kernels, EPERM under seccomp
+        }
+
+        auto ring = std::make_unique<Ring>();
+        ring->fd = ringFd;
+        if (!supportsOpcodes(ringFd)) {
+            return nullptr;
+        }
+        ring->entries = params.sq_entries;
+        ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            ring->sqRingSize = ring->cqRingSize = std::max(ring->sqRingSize, ring->cqRingSize);
+        }
+
+        void* sq = ::mmap(nullptr, ring->sqRingSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sq == MAP_FAILED) {
+            return nullptr;
+        }
+        ring->sqRing = sq;
+
+        void* cq = sq;
+        if (!singleMap) {
+            cq = ::mmap(nullptr, ring->cqRingSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if (cq == MAP_FAILED) {
+                return nullptr;
+            }
+        }
+        ring->cqRing = cq;
+
+        ring->sqeMemorySize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, ring->sqeMemorySize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return nullptr;
+        }
+        ring->sqeMemory = sqes;
+        ring->sqes = static_cast<io_uring_sqe*>(sqes);
+
+        char* sqBase = static_cast<char*>(sq);
+        char* cqBase = static_cast<char*>(cq);
+        ring->sqTail = reinterpret_cast<unsigned*>(sqBase + params.sq_off.tail);
+        ring->sqMask = reinterpret_cast<unsigned*>(sqBase + params.sq_off.ring_mask);
+        ring->sqArray = reinterpret_cast<unsigned*>(sqBase + params.sq_off.array);
+        ring->cqHead = reinterpret_cast<unsigned*>(cqBase + params.cq_off.head);
+        ring->cqTail = reinterpret_cast<unsigned*>(cqBase + params.cq_off.tail);
+        ring->cqMask = reinterpret_cast<unsigned*>(cqBase + params.cq_off.ring_mask);
+        ring->cqes = reinterpret_cast<io_uring_cqe*>(cqBase + params.cq_off.cqes);
+
+        // At most sq_entries requests are in flight, so the completion
+        // queue (twice as large) can never overflow
+        ring->slots.resize(ring->entries);
+        for (unsigned slot = ring->entries; slot > 0; --slot) {
+            ring->freeSlots.push_back(slot - 1);
+        }
+        return ring;
+    }
+
+    /**
+     * @brief Whether the kernel supports every opcode prepare() uses
+     *
+     * io_uring_setup() succeeds from 5.1 on, but IORING_OP_READ/WRITE
+     * (and the probe itself) only arrived in 5.6; before that every
+     * request would fail with EINVAL. A failed probe means "too old".
+     */
+    static bool supportsOpcodes(int ringFd) {
+        constexpr unsigned kProbeOps = 256;
+        std::vector<unsigned char> buffer(
+            sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op), 0);
+        auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+        if (::syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) {
+            return false;
+        }
+        for (int opcode : { IORING_OP_NOP, IORING_OP_READ, IORING_OP_WRITE,
+                            IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED }) {
+            if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Write one submission queue entry
+     */
+    void prepare(std::uint64_t userData, const IoRequest* request, std::size_t done) {
+        const unsigned tail = *sqTail;
+        const unsigned index = tail & *sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+
+        if (!request) {
+            sqe.opcode = IORING_OP_NOP;
+        } else {
+            const bool fixed = request->bufferIndex >= 0 && buffersRegistered;
+            const bool read = request->operation == IoOperation::Read;
+            sqe.opcode = static_cast<std::uint8_t>(
+                read ? (fixed ? IORING_OP_READ_FIXED : IORING_OP_READ)
+                     : (fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE));
+            sqe.fd = request->fd;
+            sqe.off = request->offset + done;
+            sqe.addr = reinterpret_cast<std::uint64_t>(static_cast<char*>(request->buffer) + done);
+            sqe.len = static_cast<std::uint32_t>(std::min(request->length - done, kMaxRingTransfer));
+            if (fixed) {
+                sqe.buf_index = static_cast<std::uint16_t>(request->bufferIndex);
+            }
+        }
+        sqe.user_data = userData;
+
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++pendingSubmissions;
+    }
+
+    /**
+     * @brief Hand the prepared entries to the kernel in one call
+     */
+    void enter() {
+        while (pendingSubmissions > 0) {
+            const long submitted = ::syscall(__NR_io_uring_enter, fd, pendingSubmissions, 0, 0,
+                                             nullptr, 0);
+            if (submitted < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    continue;
+                }
+                break;
+            }
+            pendingSubmissions -= static_cast<unsigned>(submitted);
+        }
+    }
+#endif
+};
+
+// ==== CONSTRUCTOR / DESTRUCTOR ====
+
+/**
+ * @brief Constructor - sets up the ring or the worker threads
+ */
+AsyncIo::AsyncIo(std::size_t queueDepth, IoExecutor executor, IoBackend backend)
+    : m_executor(std::move(executor))
+    , m_outstanding(0)
+    , m_stopping(false)
+{
+    queueDepth = std::max<std::size_t>(queueDepth, 1);
+
+#ifdef PRMS_HAVE_IO_URING
+    if (backend == IoBackend::Auto) {
+        m_ring = Ring::open(static_cast<unsigned>(std::min<std::size_t>(queueDepth, 4096)));
+    }
+    if (m_ring) {
+        m_threads.emplace_back(&AsyncIo::runReaper, this);
+        return;
+    }
+#endif
+
+    const std::size_t workers = std::min(queueDepth, kIoWorkerThreads);
+    for (std::size_t i = 0; i < workers; ++i) {
+        m_threads.emplace_back(&AsyncIo::runWorker, this);
+    }
+}
+
+/**
+ * @brief Destructor - waits for outstanding requests
+ */
+AsyncIo::~AsyncIo() {
+    drain();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+#ifdef PRMS_HAVE_IO_URING
+        if (m_ring) {
+            m_ring->prepare(kWakeTag, nullptr, 0);
+            m_ring->enter();
+        }
+#endif
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+const char* AsyncIo::getBackendName() const {
+    return m_ring ? "io_uring" : "threads";
+}
+
+// ==== REQUESTS ====
+
+/**
+ * @brief Register buffers that requests can name by index
+ */
+bool AsyncIo::registerBuffers(const std::vector<std::pair<void*, std::size_t>>& buffers) {
+#ifdef PRMS_HAVE_IO_URING
+    if (m_ring) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_ring->buffersRegistered) {
+            ::syscall(__NR_io_uring_register, m_ring->fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+            m_ring->buffersRegistered = false;
+        }
+        std::vector<iovec> vectors;
+        for (const auto& buffer : buffers) {
+            vectors.push_back(iovec{ buffer.first, buffer.second });
+        }
+        m_ring->buffersRegistered = ::syscall(__NR_io_uring_register, m_ring->fd,
+                                              IORING_REGISTER_BUFFERS, vectors.data(),
+                                              static_cast<unsigned>(vectors.size())) == 0;
+        return m_ring->buffersRegistered;
+    }
+#endif
+    (void)buffers;
+    return true;
+}
+
+/**
+ * @brief Queue a batch of requests
+ *
+ * With io_uring, as much of the batch as fits in the ring goes to the
+ * kernel in a single system call; the rest is submitted as earlier
+ * requests complete.
+ */
+void AsyncIo::submit(std::vector<IoRequest> batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_outstanding += batch.size();
+    for (IoRequest& request : batch) {
+        m_queue.push_back(std::move(request));
+    }
+
+#ifdef PRMS_HAVE_IO_URING
+    if (m_ring) {
+        while (!m_queue.empty() && !m_ring->freeSlots.empty()) {
+            const unsigned slot = m_ring->freeSlots.back();
+            m_ring->freeSlots.pop_back();
+            m_ring->slots[slot].request = std::move(m_queue.front());
+            m_ring->slots[slot].done = 0;
+            m_queue.pop_front();
+            m_ring->prepare(slot, &m_ring->slots[slot].request, 0);
+        }
+        m_ring->enter();
+        return;
+    }
+#endif
+    m_wake.notify_all();
+}
+
+/**
+ * @brief Wait until every submitted request has completed
+ */
+void AsyncIo::drain() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_outstanding == 0; });
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Body of the thread pool workers
+ */
+void AsyncIo::runWorker() {
+    while (true) {
+        IoRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return; // Stopping and nothing left
+            }
+            request = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        complete(request, perform(request));
+    }
+}
+
+/**
+ * @brief Body of the io_uring completion thread
+ *
+ * Sleeps in the kernel until completions arrive. A short transfer that
+ * is not at end of file is resubmitted for the rest; finished requests
+ * free their slot, which lets queued requests into the ring.
+ */
+void AsyncIo::runReaper() {
+#ifdef PRMS_HAVE_IO_URING
+    Ring& ring = *m_ring;
+    while (true) {
+        // Interrupted or not, whatever has completed is processed below
+        ::syscall(__NR_io_uring_enter, ring.fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+        std::vector<std::pair<IoRequest, std::int64_t>> finished;
+        bool stop = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            unsigned head = *ring.cqHead;
+            const unsigned tail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = ring.cqes[head & *ring.cqMask];
+                if (cqe.user_data == kWakeTag) {
+                    stop = m_stopping;
+                    continue;
+                }
+
+                const unsigned slot = static_cast<unsigned>(cqe.user_data);
+                Ring::Slot& entry = ring.slots[slot];
+                if (cqe.res > 0 && entry.done + static_cast<std::size_t>(cqe.res) < entry.request.length) {
+                    entry.done += static_cast<std::size_t>(cqe.res);
+                    ring.prepare(slot, &entry.request, entry.done);
+                    continue;
+                }
+
+                const std::int64_t result = cqe.res < 0 ? cqe.res
+                                                        : static_cast<std::int64_t>(entry.done + cqe.res);
+                finished.emplace_back(std::move(entry.request), result);
+                ring.freeSlots.push_back(slot);
+            }
+            __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+
+            while (!m_queue.empty() && !ring.freeSlots.empty()) {
+                const unsigned slot = ring.freeSlots.back();
+                ring.freeSlots.pop_back();
+                ring.slots[slot].request = std::move(m_queue.front());
+                ring.slots[slot].done = 0;
+                m_queue.pop_front();
+                ring.prepare(slot, &ring.slots[slot].request, 0);
+            }
+            ring.enter();
+        }
+
+        for (auto& entry : finished) {
+            complete(entry.first, entry.second);
+        }
+        if (stop) {
+            return;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Run one request with blocking calls
+ *
+ * Loops over short transfers; a read returning 0 means end of file.
+ */
+std::int64_t AsyncIo::perform(const IoRequest& request) {
+    char* data = static_cast<char*>(request.buffer);
+    std::size_t done = 0;
+    while (done < request.length) {
+        const off_t position = static_cast<off_t>(request.offset + done);
+        const ssize_t result = request.operation == IoOperation::Read
+            ? ::pread(request.fd, data + done, request.length - done, position)
+            : ::pwrite(request.fd, data + done, request.length - done, position);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -errno;
+        }
+        if (result == 0) {
+            break;
+        }
+        done += static_cast<std::size_t>(result);
+    }
+    return static_cast<std::int64_t>(done);
+}
+
+/**
+ * @brief Report a finished request and update the in-flight count
+ */
+void AsyncIo::complete(IoRequest& request, std::int64_t result) {
+    if (request.onComplete) {
+        if (m_executor) {
+            m_executor([callback = std::move(request.onComplete), result]() { callback(result); });
+        } else {
+            request.onComplete(result);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_outstanding == 0) {
+        m_idle.notify_all();
+    }
+}
+
+// ==== WHOLE-FILE HELPERS ====
+
+/**
+ * @brief Read several files completely, in parallel
+ *
+ * Sizes come from fstat(), so each file is a single request.
+ */
+std::vector<std::optional<std::string>> readFiles(AsyncIo& io, const std::vector<std::string>& paths) {
+    std::vector<std::optional<std::string>> contents(paths.size());
+    std::vector<int> fds(paths.size(), -1);
+    auto batchResults = std::make_shared<BatchResults>(paths.size());
+
+    std::vector<IoRequest> batch;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        fds[i] = ::open(paths[i].c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat info;
+        if (fds[i] < 0 || ::fstat(fds[i], &info) != 0) {
+            continue;
+        }
+
+        contents[i].emplace(static_cast<std::size_t>(info.st_size), '\0');
+        IoRequest request;
+        request.operation = IoOperation::Read;
+        request.fd = fds[i];
+        request.buffer = contents[i]->data();
+        request.length = contents[i]->size();
+        request.onComplete = batchResults->recorder(batchResults, i);
+        batch.push_back(std::move(request));
+    }
+    io.submit(std::move(batch));
+    batchResults->wait();
+
+    const std::vector<std::int64_t>& results = batchResults->results;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (fds[i] >= 0) {
+            ::close(fds[i]);
+        }
+        if (contents[i] && results[i] < 0) {
+            contents[i].reset();
+        } else if (contents[i]) {
+            contents[i]->resize(static_cast<std::size_t>(results[i])); // Shrunk while reading
+        }
+    }
+    return contents;
+}
+
+/**
+ * @brief Write several files completely, in parallel
+ */
+std::vector<bool> writeFiles(AsyncIo& io,
+                             const std::vector<std::pair<std::string, std::string>>& files,
+                             bool sync) {
+    std::vector<bool> written(files.size(), false);
+    std::vector<int> fds(files.size(), -1);
+    auto batchResults = std::make_shared<BatchResults>(files.size());
+
+    std::vector<IoRequest> batch;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        fds[i] = ::open(files[i].first.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fds[i] < 0) {
+            continue;
+        }
+
+        IoRequest request;
+        request.operation = IoOperation::Write;
+        request.fd = fds[i];
+        request.buffer = const_cast<char*>(files[i].second.data());
+        request.length = files[i].second.size();
+        request.onComplete = batchResults->recorder(batchResults, i);
+        batch.push_back(std::move(request));
+    }
+    io.submit(std::move(batch));
+    batchResults->wait();
+
+    const std::vector<std::int64_t>& results = batchResults->results;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        if (fds[i] < 0) {
+            continue;
+        }
+        written[i] = results[i] == static_cast<std::int64_t>(files[i].second.size()) &&
+                     (!sync || ::fsync(fds[i]) == 0);
+        written[i] = ::close(fds[i]) == 0 && written[i];
+    }
+    return written;
+}
@@ -9,6 +9,7 @@
  */
 
 #include "book.h"
+#include "book_schema.h"
 #include <stdexcept>
 #include <algorithm>
 
@@ -21,7 +22,7 @@
  * This is used when you need a Book object but don't have
  * the data yet (like when loading from a database).
  */
-Book:Book()
+Book::Book()
     : m_id(0) // Initialize ID to 0 (not set)
     , m_title("") // Initialize title to empty string
     , m_author("") // Initialize author to empty string
@@ -30,6 +31,12 @@ Book:Book()
     , m_currentPage(0) // Initialize current page to 0
     , m_startDate(std::nullopt) // Initialize start date to "not set"
     , m_completionDate(std::nullopt) // Initialize completion date to "not set"
+    , m_genre("") // Genre not known yet
+    , m_publisher("") // Publisher not known yet
+    , m_year(0) // Year not known yet
+    , m_review() // No review yet
+    , m_notes() // No notes yet
+    , m_loadedFields(kAllBookFields) // A book built in memory has every field
 {
     // Constructor body is empty because we initialized everything above
     // This is called "member initializer list"
@@ -53,28 +60,41 @@ Book::Book(const std::string& title, const std::string& author,
     , m_currentPage(0) // Start at page 0 (not started yet)
     , m_startDate(std::nullopt) // Initialize start date to "not set"
     , m_completionDate(std::nullopt) // Initialize completion date to "not set"
+    , m_genre("") // Genre not known yet
+    , m_publisher("") // Publisher not known yet
+    , m_year(0) // Year not known yet
+    , m_review() // No review yet
+    , m_notes() // No notes yet
+    , m_loadedFields(kAllBookFields) // A book built in memory has every field
 {
-    // Validate the input data
-
-    if (pageCount < 0) {
-        throw std::invalid_argument("Page count cannot be negative");
-    }
-
-    if (title.empty()) {
-        throw std::invalid_argument("Title cannot be empty");
-    }
-
-    if (author.empty()) {
-        throw std::invalid_argument("Author cannot be empty");
+    // Validate the input data with the schema's rules
+    if (const char* error = BookSchema::validate(*this, kCoreBookFields)) {
+        throw std::invalid_argument(error);
     }
+}
 
-    if (!isbn.empty() && isbn.length() != 13) {
-        throw std::invalid_argument("ISBN must be 13 digits");
-    }
+/**
+ * @brief Create a partial book holding only some fields of another
+ * @param source The book to copy from
+ * @param fields The fields to keep (the ID is always kept)
+ */
+Book Book::partialCopy(const Book& source, BookFieldMask fields) {
+    Book book;
+    book.m_loadedFields = 0;
+    book.copyFieldsFrom(source, fields | BookField::Id);
+    return book;
 }
 
 // ==== GETTER METHODS ====
 
+/**
+ * @brief Get the unique identifier of the book
+ * @return The book's ID (0 if not yet saved)
+ */
+int Book::getId() const {
+    return m_id;
+}
+
 /**
  * @brief Get the title of the book
  * @return The title of the book
@@ -129,6 +149,30 @@ const std::optional<std::chrono::system_clock::time_point>& Book::getCompletionD
     return m_completionDate;
 }
 
+/**
+ * @brief Get the genre of the book
+ * @return The genre (empty if unknown)
+ */
+const std::string& Book::getGenre() const {
+    return m_genre;
+}
+
+/**
+ * @brief Get the publisher of the book
+ * @return The publisher (empty if unknown)
+ */
+const std::string& Book::getPublisher() const {
+    return m_publisher;
+}
+
+/**
+ * @brief Get the publication year of the book
+ * @return The year (0 if unknown)
+ */
+int Book::getYear() const {
+    return m_year;
+}
+
 /**
  * @brief Calculate reading progress as a percentage
  * @return Progress percentage (0.0 to 100.0)
@@ -155,6 +199,45 @@ double Book::getProgressPercentage() const {
     return std::min(percentage, 100.0);
 }
 
+/**
+ * @brief Get the user's review of the book
+ */
+const LazyText& Book::getReview() const {
+    return m_review;
+}
+
+/**
+ * @brief Get the user's notes on the book
+ */
+const LazyText& Book::getNotes() const {
+    return m_notes;
+}
+
+/**
+ * @brief Get the set of fields that hold real data
+ * @return Mask of BookField bits
+ */
+BookFieldMask Book::getLoadedFields() const {
+    return m_loadedFields;
+}
+
+/**
+ * @brief Check whether a field was loaded
+ * @param field The field to check
+ * @return True if the field holds real data
+ */
+bool Book::hasField(BookField field) const {
+    return (m_loadedFields & toMask(field)) != 0;
+}
+
+/**
+ * @brief Check whether this book holds every persisted field
+ * @return True if no field was left out by a projection
+ */
+bool Book::isComplete() const {
+    return (m_loadedFields & kAllBookFields) == kAllBookFields;
+}
+
 // ==== SETTER METHODS ====
 
 /**
@@ -162,10 +245,9 @@ double Book::getProgressPercentage() const {
  * @param id The unique ID (usually set by the database)
  */
 void Book::setId(int id) {
-    if (id < 0) {
-        throw std::invalid_argument("ID cannot be negative");
-    }
+    BookSchema::require<BookSchema::IdField>(id);
     m_id = id;
+    m_loadedFields |= toMask(BookField::Id);
 }
 
 /**
@@ -173,10 +255,9 @@ void Book::setId(int id) {
  * @param title The new title
  */
 void Book::setTitle(const std::string& title) {
-    if (title.empty()) {
-        throw std::invalid_argument("Title cannot be empty");
-    }
+    BookSchema::require<BookSchema::TitleField>(title);
     m_title = title;
+    m_loadedFields |= toMask(BookField::Title);
 }
 
 /**
@@ -184,10 +265,9 @@ void Book::setTitle(const std::string& title) {
  * @param author The new author
  */
 void Book::setAuthor(const std::string& author) {
-    if (author.empty()) {
-        throw std::invalid_argument("Author cannot be empty");
-    }
+    BookSchema::require<BookSchema::AuthorField>(author);
     m_author = author;
+    m_loadedFields |= toMask(BookField::Author);
 }
 
 /**
@@ -195,10 +275,9 @@ void Book::setAuthor(const std::string& author) {
  * @param isbn The new ISBN
  */
 void Book::setISBN(const std::string& isbn) {
-    if (!isbn.empty() && isbn.length() != 13) {
-        throw std::invalid_argument("ISBN must be 13 digits");
-    }
+    BookSchema::require<BookSchema::IsbnField>(isbn);
     m_isbn = isbn;
+    m_loadedFields |= toMask(BookField::Isbn);
 }
 
 /**
@@ -206,51 +285,115 @@ void Book::setISBN(const std::string& isbn) {
  * @param pageCount The new page count
  */
 void Book::setPageCount(int pageCount) {
-    if (pageCount < 0) {
-        throw std::invalid_argument("Page count cannot be negative");
-    }
+    BookSchema::require<BookSchema::PageCountField>(pageCount);
     m_pageCount = pageCount;
+    m_loadedFields |= toMask(BookField::PageCount);
 
     // If current page is greater than page count, set it to page count
     if (m_currentPage > pageCount) {
         m_currentPage = pageCount;
+        m_loadedFields |= toMask(BookField::CurrentPage);
     }
 }
 
 /**
  * @brief Set the current page that the user is on
  * @param currentPage The new current page
+ *
+ * On a partial book an unloaded date reads as "not set"; it is only
+ * stamped when the previous page was loaded too and shows the book really
+ * starts or ends now, so a stored date is not overwritten.
  */
 void Book::setCurrentPage(int currentPage) {
-    if (currentPage < 0) {
-        throw std::invalid_argument("Current page cannot be negative");
-    }
+    BookSchema::require<BookSchema::CurrentPageField>(currentPage);
 
     if (currentPage > m_pageCount && m_pageCount > 0) {
         throw std::invalid_argument("Current page cannot be greater than page count");
     }
 
+    const bool pageLoaded = hasField(BookField::CurrentPage);
+    const int previousPage = m_currentPage;
     m_currentPage = currentPage;
+    m_loadedFields |= toMask(BookField::CurrentPage);
 
     // Automatically set start date if not set and we're starting to read
-    if (currentPage > 0 && !m_startDate) {
+    if (currentPage > 0 && !m_startDate && (hasField(BookField::StartDate) || (pageLoaded && previousPage == 0))) {
         m_startDate = std::chrono::system_clock::now();
+        m_loadedFields |= toMask(BookField::StartDate);
     }
 
     // Automatically set completion date if we've reached the end
-    if (currentPage == m_pageCount && > 0 && !m_completionDate.has_value()) {
+    if (currentPage == m_pageCount && m_pageCount > 0 && !m_completionDate.has_value() &&
+        (hasField(BookField::CompletionDate) || (pageLoaded && previousPage != m_pageCount))) {
         m_completionDate = std::chrono::system_clock::now();
+        m_loadedFields |= toMask(BookField::CompletionDate);
     }
 }
 
+/**
+ * @brief Set the date when the reading was started
+ * @param startDate The new start date
+ */
+void Book::setStartDate(const std::chrono::system_clock::time_point& startDate) {
+    m_startDate = startDate;
+    m_loadedFields |= toMask(BookField::StartDate);
+}
+
 /**
  * @brief Set the date when the reading was completed
  * @param completionDate The new completion date
  */
 void Book::setCompletionDate(const std::chrono::system_clock::time_point& completionDate) {
     m_completionDate = completionDate;
+    m_loadedFields |= toMask(BookField::CompletionDate);
 }
 
+/**
+ * @brief Set the genre of the book
+ * @param genre The new genre
+ */
+void Book::setGenre(const std::string& genre) {
+    m_genre = genre;
+    m_loadedFields |= toMask(BookField::Genre);
+}
+
+/**
+ * @brief Set the publisher of the book
+ * @param publisher The new publisher
+ */
+void Book::setPublisher(const std::string& publisher) {
+    m_publisher = publisher;
+    m_loadedFields |= toMask(BookField::Publisher);
+}
+
+/**
+ * @brief Set the publication year of the book
+ * @param year The new year (0 if unknown)
+ */
+void Book::setYear(int year) {
+    BookSchema::require<BookSchema::YearField>(year);
+    m_year = year;
+    m_loadedFields |= toMask(BookField::Year);
+}
+
+
+/**
+ * @brief Set the user's review of the book
+ * @param review The new review
+ */
+void Book::setReview(const std::string& review) {
+    m_review.set(review);
+    m_loadedFields |= toMask(BookField::Review);
+}
+
+/**
+ * @brief Set the user's notes on the book
+ * @param notes The new notes
+ */
+void Book::setNotes(const std::string& notes) {
+    m_notes.set(notes);
+    m_loadedFields |= toMask(BookField::Notes);
+}
 
 // ==== UTILITY METHODS ====
 
@@ -280,6 +423,7 @@ void Book::markAsCompleted() {
 
     m_currentPage = m_pageCount;
     m_completionDate = std::chrono::system_clock::now();
+    m_loadedFields |= BookField::CurrentPage | BookField::CompletionDate;
 }
 
 /**
@@ -289,4 +433,30 @@ void Book::resetProgress() {
     m_currentPage = 0;
     m_startDate = std::nullopt;
     m_completionDate = std::nullopt;
-}
\ No newline at end of file
+    m_loadedFields |= BookField::CurrentPage | BookField::StartDate | BookField::CompletionDate;
+}
+
+/**
+ * @brief Copy some fields from another book
+ * @param other The book to copy from
+ * @param fields The fields to copy
+ */
+void Book::copyFieldsFrom(const Book& other, BookFieldMask fields) {
+    BookSchema::copyFields(*this, other, fields);
+    if (fields & toMask(BookField::Review)) {
+        m_review = other.m_review;
+    }
+    if (fields & toMask(BookField::Notes)) {
+        m_notes = other.m_notes;
+    }
+    m_loadedFields |= fields & kAllBookFields;
+}
+
+/**
+ * @brief Find the core fields whose values differ from another book
+ * @param other The book to compare with
+ * @return Mask of differing core fields
+ */
+BookFieldMask Book::getDifferentFields(const Book& other) const {
+    return BookSchema::differentFields(*this, other);
+}
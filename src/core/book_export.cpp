@@ -0,0 +1,165 @@
+/**
+ * @file book_export.cpp
+ * @brief CSV and JSON writers for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "book_export.h"
+#include "book_schema.h"
+#include <cstdio>
+
+namespace {
+
+/**
+ * @brief Format a date as UTC ISO 8601
+ *
+ * Uses the days-to-civil conversion from Howard Hinnant's date
+ * algorithms, which is pure arithmetic and thread safe (unlike gmtime).
+ */
+std::string formatDate(const std::chrono::system_clock::time_point& time) {
+    long long seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        time.time_since_epoch()).count();
+    long long days = seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400;
+    long long secondOfDay = seconds - days * 86400;
+
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    long long dayOfEra = days - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long monthIndex = (5 * dayOfYear + 2) / 153;
+    long long day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    long long month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    long long year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "%04lld-%02lld-%02lldT%02lld:%02lld:%02lldZ",
+                  year, month, day, secondOfDay / 3600, secondOfDay / 60 % 60, secondOfDay % 60);
+    return buffer;
+}
+
+// ==== CSV VALUE WRITERS ====
+
+void writeCsvValue(std::ostream& out, int value) {
+    out << value;
+}
+
+/**
+ * @brief Write text, quoting it if it holds a separator, quote or newline
+ */
+void writeCsvValue(std::ostream& out, const std::string& value) {
+    if (value.find_first_of(",\"\r\n") == std::string::npos) {
+        out << value;
+        return;
+    }
+    out << '"';
+    for (char c : value) {
+        if (c == '"') {
+            out << '"';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+void writeCsvValue(std::ostream& out, const BookSchema::Date& date) {
+    if (date) {
+        out << formatDate(*date);
+    }
+}
+
+// ==== JSON VALUE WRITERS ====
+
+void writeJsonValue(std::ostream& out, int value) {
+    out << value;
+}
+
+/**
+ * @brief Write a JSON string with the required escapes
+ */
+void writeJsonValue(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    out << escape;
+                } else {
+                    out << static_cast<char>(c);
+                }
+        }
+    }
+    out << '"';
+}
+
+void writeJsonValue(std::ostream& out, const BookSchema::Date& date) {
+    if (date) {
+        out << '"' << formatDate(*date) << '"';
+    } else {
+        out << "null";
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Write books as CSV with a header row
+ */
+void writeBooksCsv(std::ostream& out, const std::vector<Book>& books, BookFieldMask fields) {
+    bool first = true;
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        if (fields & F::bit) {
+            out << (first ? "" : ",") << F::name;
+            first = false;
+        }
+    });
+    out << "\r\n";
+
+    for (const Book& book : books) {
+        first = true;
+        BookSchema::Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            if (fields & F::bit) {
+                out << (first ? "" : ",");
+                if (book.hasField(F::field)) {
+                    writeCsvValue(out, F::get(book));
+                }
+                first = false;
+            }
+        });
+        out << "\r\n";
+    }
+}
+
+/**
+ * @brief Write books as a JSON array of objects
+ */
+void writeBooksJson(std::ostream& out, const std::vector<Book>& books, BookFieldMask fields) {
+    out << "[";
+    for (std::size_t i = 0; i < books.size(); ++i) {
+        const Book& book = books[i];
+        out << (i == 0 ? "\n  {" : ",\n  {");
+
+        bool first = true;
+        BookSchema::Fields::forEach([&](auto descriptor) {
+            using F = decltype(descriptor);
+            if ((fields & F::bit) && book.hasField(F::field)) {
+                out << (first ? "" : ", ") << '"' << F::name << "\": ";
+                writeJsonValue(out, F::get(book));
+                first = false;
+            }
+        });
+        out << "}";
+    }
+    out << (books.empty() ? "]\n" : "\n]\n");
+}
@@ -0,0 +1,330 @@
+/**
+ * @file book_query.cpp
+ * @brief Implementation of the filter queries for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "book_query.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace {
+
+// Bits of the kernel table index: which numeric predicates are active
+constexpr std::size_t kStateBit = 1 << 0;
+constexpr std::size_t kPageCountBit = 1 << 1;
+constexpr std::size_t kCurrentPageBit = 1 << 2;
+constexpr std::size_t kStartDateBit = 1 << 3;
+constexpr std::size_t kCompletionDateBit = 1 << 4;
+constexpr std::size_t kKernelCount = 1 << 5;
+
+/**
+ * @brief The fused scan loop for one combination of predicates
+ *
+ * Inactive predicates are compiled out. Active ones are combined with
+ * bitwise ANDs and the row index is written unconditionally, advancing
+ * the output only on a match, so the loop has no data-dependent branch
+ * and runs at the speed of streaming the columns.
+ */
+template <std::size_t Active>
+std::size_t scanChunk(const BookChunk& chunk, const BookQuery::Bounds& bounds, std::uint32_t* rows) {
+    const int* pageCounts = chunk.pageCounts.data();
+    const int* currentPages = chunk.currentPages.data();
+    const std::int64_t* startDates = chunk.startDates.data();
+    const std::int64_t* completionDates = chunk.completionDates.data();
+    const std::uint32_t size = static_cast<std::uint32_t>(chunk.size());
+
+    // ReadingState values 1..3 map to bits 0..2 of the wanted mask
+    const unsigned wantedStates = bounds.state == ReadingState::Any
+        ? 7u : 1u << (static_cast<unsigned>(bounds.state) - 1u);
+
+    std::size_t count = 0;
+    for (std::uint32_t i = 0; i < size; ++i) {
+        bool match = true;
+        if constexpr ((Active & kPageCountBit) != 0) {
+            match &= (pageCounts[i] >= bounds.pageMin) & (pageCounts[i] <= bounds.pageMax);
+        }
+        if constexpr ((Active & kCurrentPageBit) != 0) {
+            match &= (currentPages[i] >= bounds.currentMin) & (currentPages[i] <= bounds.currentMax);
+        }
+        if constexpr ((Active & kStartDateBit) != 0) {
+            match &= (startDates[i] >= bounds.startMin) & (startDates[i] <= bounds.startMax);
+        }
+        if constexpr ((Active & kCompletionDateBit) != 0) {
+            match &= (completionDates[i] >= bounds.completionMin) &
+                     (completionDates[i] <= bounds.completionMax);
+        }
+        if constexpr ((Active & kStateBit) != 0) {
+            // Same rules as isInState(): 0 not started, 1 in progress, 2 completed
+            const bool completed = ((pageCounts[i] > 0) & (currentPages[i] == pageCounts[i])) |
+                                   (completionDates[i] != kNoDate);
+            const unsigned state = completed ? 2u : static_cast<unsigned>(currentPages[i] > 0);
+            match &= ((wantedStates >> state) & 1u) != 0;
+        }
+        rows[count] = i;
+        count += match;
+    }
+    return count;
+}
+
+template <std::size_t... Active>
+constexpr std::array<BookQuery::Kernel, kKernelCount> makeKernels(std::index_sequence<Active...>) {
+    return { &scanChunk<Active>... };
+}
+
+/// One fused loop per combination of active numeric predicates
+constexpr std::array<BookQuery::Kernel, kKernelCount> kKernels =
+    makeKernels(std::make_index_sequence<kKernelCount>{});
+
+/**
+ * @brief Convert a date bound to the column representation
+ *
+ * Clamped above kNoDate so rows without the date never match.
+ */
+std::int64_t columnBound(const std::chrono::system_clock::time_point& time) {
+    std::int64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        time.time_since_epoch()).count();
+    return std::max(seconds, kNoDate + 1);
+}
+
+/**
+ * @brief Convert an optional date to the column representation
+ */
+std::int64_t columnDate(const std::optional<std::chrono::system_clock::time_point>& date) {
+    if (!date) {
+        return kNoDate;
+    }
+    return std::chrono::duration_cast<std::chrono::seconds>(date->time_since_epoch()).count();
+}
+
+} // namespace
+
+/**
+ * @brief Constructor - compiles a filter
+ *
+ * Unset predicates get bounds that every row satisfies, but they are
+ * also left out of the kernel, so they cost nothing in the scan.
+ */
+BookQuery::BookQuery(const BookFilter& filter)
+    : m_filter(filter)
+    , m_bounds()
+    , m_kernel(nullptr)
+{
+    const PageRange allPages;
+    const DateRange allDates;
+    const PageRange& pages = filter.pageCount ? *filter.pageCount : allPages;
+    const PageRange& current = filter.currentPage ? *filter.currentPage : allPages;
+    const DateRange& started = filter.startDate ? *filter.startDate : allDates;
+    const DateRange& completed = filter.completionDate ? *filter.completionDate : allDates;
+
+    m_bounds.state = filter.state;
+    m_bounds.pageMin = pages.min;
+    m_bounds.pageMax = pages.max;
+    m_bounds.currentMin = current.min;
+    m_bounds.currentMax = current.max;
+    m_bounds.startMin = columnBound(started.from);
+    m_bounds.startMax = columnBound(started.to);
+    m_bounds.completionMin = columnBound(completed.from);
+    m_bounds.completionMax = columnBound(completed.to);
+
+    std::size_t active = 0;
+    active |= filter.state != ReadingState::Any ? kStateBit : 0;
+    active |= filter.pageCount ? kPageCountBit : 0;
+    active |= filter.currentPage ? kCurrentPageBit : 0;
+    active |= filter.startDate ? kStartDateBit : 0;
+    active |= filter.completionDate ? kCompletionDateBit : 0;
+    m_kernel = kKernels[active];
+}
+
+const BookFilter& BookQuery::getFilter() const {
+    return m_filter;
+}
+
+/**
+ * @brief Find the matching rows of a snapshot
+ *
+ * Every chunk writes its own selection, so workers never share output.
+ */
+std::vector<ChunkSelection> BookQuery::select(const BookTableSnapshot& snapshot) const {
+    std::vector<ChunkSelection> selections(snapshot.getChunkCount());
+    parallelFor(snapshot.getChunkCount(), [&](std::size_t, std::size_t chunk) {
+        const BookChunk& data = snapshot.getChunk(chunk);
+        ChunkSelection& selection = selections[chunk];
+        selection.chunk = static_cast<std::uint32_t>(chunk);
+        if (!mayMatch(data)) {
+            return;
+        }
+        selection.rows.resize(data.size());
+        selection.rows.resize(filterChunk(data, selection.rows.data()));
+    });
+
+    selections.erase(std::remove_if(selections.begin(), selections.end(),
+                                    [](const ChunkSelection& s) { return s.rows.empty(); }),
+                     selections.end());
+    return selections;
+}
+
+/**
+ * @brief Find the matching rows of a snapshot as a flat list
+ */
+std::vector<SnapshotRow> BookQuery::selectRows(const BookTableSnapshot& snapshot) const {
+    std::vector<SnapshotRow> rows;
+    for (const ChunkSelection& selection : select(snapshot)) {
+        for (std::uint32_t row : selection.rows) {
+            rows.push_back(SnapshotRow{ selection.chunk, row });
+        }
+    }
+    return rows;
+}
+
+/**
+ * @brief Count the matching books of a snapshot
+ *
+ * Uses one scratch selection per worker instead of keeping every
+ * chunk's rows.
+ */
+std::size_t BookQuery::count(const BookTableSnapshot& snapshot) const {
+    const std::size_t chunkCount = snapshot.getChunkCount();
+    const std::size_t workers = getWorkerCount(chunkCount);
+    std::vector<std::vector<std::uint32_t>> scratch(workers,
+                                                    std::vector<std::uint32_t>(kBookChunkCapacity));
+    std::vector<std::size_t> counts(workers, 0);
+
+    parallelFor(chunkCount, [&](std::size_t worker, std::size_t chunk) {
+        const BookChunk& data = snapshot.getChunk(chunk);
+        if (scratch[worker].size() < data.size()) {
+            scratch[worker].resize(data.size());
+        }
+        counts[worker] += filterChunk(data, scratch[worker].data());
+    });
+
+    std::size_t total = 0;
+    for (std::size_t count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * @brief Build the matching books of a snapshot
+ */
+std::vector<Book> BookQuery::fetch(const BookTableSnapshot& snapshot) const {
+    std::vector<Book> books;
+    for (const ChunkSelection& selection : select(snapshot)) {
+        const BookChunk& chunk = snapshot.getChunk(selection.chunk);
+        for (std::uint32_t row : selection.rows) {
+            books.push_back(chunk.getBook(row));
+        }
+    }
+    return books;
+}
+
+/**
+ * @brief Check one book against the filter
+ */
+bool BookQuery::matches(const Book& book) const {
+    const std::int64_t startDate = columnDate(book.getStartDate());
+    const std::int64_t completionDate = columnDate(book.getCompletionDate());
+    return isInState(m_filter.state, book.getPageCount(), book.getCurrentPage(), completionDate) &&
+           book.getPageCount() >= m_bounds.pageMin && book.getPageCount() <= m_bounds.pageMax &&
+           book.getCurrentPage() >= m_bounds.currentMin && book.getCurrentPage() <= m_bounds.currentMax &&
+           (!m_filter.startDate ||
+            (startDate >= m_bounds.startMin && startDate <= m_bounds.startMax)) &&
+           (!m_filter.completionDate ||
+            (completionDate >= m_bounds.completionMin && completionDate <= m_bounds.completionMax)) &&
+           (!m_filter.author || book.getAuthor() == *m_filter.author) &&
+           (!m_filter.genre || book.getGenre() == *m_filter.genre) &&
+           (!m_filter.publisher || book.getPublisher() == *m_filter.publisher) &&
+           (!m_filter.year ||
+            (book.getYear() >= m_filter.year->min && book.getYear() <= m_filter.year->max));
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Check a chunk's zone maps against the range predicates
+ *
+ * "Completed in 2019" only has to scan chunks whose completion dates
+ * reach into 2019.
+ */
+bool BookQuery::mayMatch(const BookChunk& chunk) const {
+    return (!m_filter.pageCount ||
+            chunk.pageCountZone.overlaps(m_bounds.pageMin, m_bounds.pageMax)) &&
+           (!m_filter.currentPage ||
+            chunk.currentPageZone.overlaps(m_bounds.currentMin, m_bounds.currentMax)) &&
+           (!m_filter.startDate ||
+            chunk.startDateZone.overlaps(m_bounds.startMin, m_bounds.startMax)) &&
+           (!m_filter.completionDate ||
+            chunk.completionDateZone.overlaps(m_bounds.completionMin, m_bounds.completionMax));
+}
+
+/**
+ * @brief Flag the dictionary codes of a chunk that pass the filter
+ *
+ * A chunk's dictionary lists every value it holds, so it doubles as a
+ * zone map: "genre = Poetry" skips chunks without any poetry.
+ */
+bool BookQuery::matchDictionaries(const BookChunk& chunk, std::vector<std::uint8_t>& genres,
+                                  std::vector<std::uint8_t>& publishers,
+                                  std::vector<std::uint8_t>& years) const {
+    if (m_filter.genre &&
+        !chunk.genres.matchCodes([&](const std::string& genre) { return genre == *m_filter.genre; },
+                                 genres)) {
+        return false;
+    }
+    if (m_filter.publisher &&
+        !chunk.publishers.matchCodes(
+            [&](const std::string& publisher) { return publisher == *m_filter.publisher; },
+            publishers)) {
+        return false;
+    }
+    if (m_filter.year &&
+        !chunk.years.matchCodes(
+            [&](int year) { return year >= m_filter.year->min && year <= m_filter.year->max; },
+            years)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Run the compiled predicates over one chunk
+ *
+ * Zone maps and dictionaries are checked first. The fused numeric loop
+ * then runs over every row, the dictionary predicates refine its
+ * selection by code, and the author compare only sees what is left.
+ */
+std::size_t BookQuery::filterChunk(const BookChunk& chunk, std::uint32_t* rows) const {
+    std::vector<std::uint8_t> genres;
+    std::vector<std::uint8_t> publishers;
+    std::vector<std::uint8_t> years;
+    if (!mayMatch(chunk) || !matchDictionaries(chunk, genres, publishers, years)) {
+        return 0;
+    }
+    std::size_t count = m_kernel(chunk, m_bounds, rows);
+
+    if (m_filter.genre) {
+        count = chunk.genres.refine(rows, count, genres);
+    }
+    if (m_filter.publisher) {
+        count = chunk.publishers.refine(rows, count, publishers);
+    }
+    if (m_filter.year) {
+        count = chunk.years.refine(rows, count, years);
+    }
+
+    if (m_filter.author) {
+        const std::string& author = *m_filter.author;
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            rows[kept] = rows[i];
+            kept += chunk.authors[rows[i]] == author;
+        }
+        count = kept;
+    }
+    return count;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file book_sort.cpp
+ * @brief Normalized key radix sort used by the Book sorting templates (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "book_sort.h"
+#include <array>
+
+namespace {
+
+/// Runs shorter than this are finished with a comparison sort
+constexpr std::size_t kRadixRunThreshold = 64;
+
+/**
+ * @brief One key being sorted: the current 8-byte slice and its position
+ */
+struct SortEntry {
+    std::uint64_t slice; // bytes [depth * 8, depth * 8 + 8) of the key, big-endian
+    std::uint32_t index; // position of the key (and the book)
+};
+
+/**
+ * @brief Read 8 bytes of a key as a big-endian integer, zero padded
+ */
+std::uint64_t readSlice(const std::string& keys, std::uint32_t begin, std::uint32_t end,
+                        std::size_t offset) {
+    std::size_t position = begin + offset;
+    if (position + 8 <= end) {
+        unsigned char bytes[8];
+        std::memcpy(bytes, keys.data() + position, sizeof(bytes));
+        std::uint64_t slice = 0;
+        for (unsigned char byte : bytes) {
+            slice = (slice << 8) | byte;
+        }
+        return slice;
+    }
+
+    std::uint64_t slice = 0;
+    for (std::size_t i = 0; i < 8; ++i, ++position) {
+        slice = (slice << 8) | (position < end ? static_cast<unsigned char>(keys[position]) : 0u);
+    }
+    return slice;
+}
+
+/**
+ * @brief Number of bytes of a key after the first skip bytes
+ */
+std::size_t remaining(const std::vector<std::uint32_t>& offsets, std::uint32_t index, std::size_t skip) {
+    const std::size_t length = offsets[index + 1] - offsets[index];
+    return length > skip ? length - skip : 0;
+}
+
+/**
+ * @brief LSD radix sort of entries by slice
+ *
+ * One histogram pass counts all 8 byte positions at once; byte positions
+ * where every slice has the same value are skipped.
+ */
+void radixSortSlices(SortEntry* first, SortEntry* last, std::vector<SortEntry>& buffer) {
+    constexpr int kPasses = 8;
+    constexpr int kBuckets = 256;
+
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    std::array<std::array<std::uint32_t, kBuckets>, kPasses> counts{};
+    for (const SortEntry* entry = first; entry != last; ++entry) {
+        for (int pass = 0; pass < kPasses; ++pass) {
+            ++counts[pass][(entry->slice >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    buffer.resize(std::max(buffer.size(), size));
+    SortEntry* source = first;
+    SortEntry* target = buffer.data();
+    for (int pass = 0; pass < kPasses; ++pass) {
+        std::array<std::uint32_t, kBuckets>& count = counts[pass];
+        if (std::find(count.begin(), count.end(), size) != count.end()) {
+            continue; // Every slice has the same byte here
+        }
+
+        std::uint32_t offset = 0;
+        for (std::uint32_t& bucket : count) {
+            std::uint32_t bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            target[count[(source[i].slice >> (pass * 8)) & 0xFF]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+
+    if (source != first) {
+        std::copy(source, source + size, first);
+    }
+}
+
+/**
+ * @brief Sort entries whose keys are equal before byte depth * 8
+ */
+void sortRange(const std::string& keys, const std::vector<std::uint32_t>& offsets,
+               SortEntry* first, SortEntry* last, std::size_t depth,
+               std::vector<SortEntry>& buffer) {
+    const std::size_t skip = depth * 8;
+
+    if (static_cast<std::size_t>(last - first) < kRadixRunThreshold) {
+        std::sort(first, last, [&](const SortEntry& a, const SortEntry& b) {
+            // Clamped: a key may end before depth * 8 if the keys are not prefix-free
+            std::size_t lengthA = remaining(offsets, a.index, skip);
+            std::size_t lengthB = remaining(offsets, b.index, skip);
+            int result = std::memcmp(keys.data() + offsets[a.index + 1] - lengthA,
+                                     keys.data() + offsets[b.index + 1] - lengthB,
+                                     std::min(lengthA, lengthB));
+            return result != 0 ? result < 0 : lengthA < lengthB;
+        });
+        return;
+    }
+
+    for (SortEntry* entry = first; entry != last; ++entry) {
+        entry->slice = readSlice(keys, offsets[entry->index], offsets[entry->index + 1], skip);
+    }
+    radixSortSlices(first, last, buffer);
+
+    // Keys are prefix-free, so within a run of equal slices either every
+    // key ends inside this slice (they are all equal) or we look further
+    for (SortEntry* start = first; start != last; ) {
+        SortEntry* end = start + 1;
+        bool longer = offsets[start->index + 1] - offsets[start->index] > skip + 8;
+        while (end != last && end->slice == start->slice) {
+            longer = longer || offsets[end->index + 1] - offsets[end->index] > skip + 8;
+            ++end;
+        }
+        if (end - start > 1 && longer) {
+            sortRange(keys, offsets, start, end, depth + 1, buffer);
+        }
+        start = end;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Sort positions by their normalized keys
+ */
+std::vector<std::uint32_t> sortNormalizedKeys(const std::string& keys,
+                                              const std::vector<std::uint32_t>& offsets) {
+    const std::size_t count = offsets.empty() ? 0 : offsets.size() - 1;
+
+    std::vector<SortEntry> entries(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        entries[i] = SortEntry{ 0, i };
+    }
+
+    std::vector<SortEntry> buffer;
+    sortRange(keys, offsets, entries.data(), entries.data() + count, 0, buffer);
+
+    std::vector<std::uint32_t> order(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        order[i] = entries[i].index;
+    }
+    return order;
+}
@@ -0,0 +1,638 @@
+/**
+ * @file book_table.cpp
+ * @brief Implementation of the BookTable class for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "book_table.h"
+#include "book_schema.h"
+#include "sort_key.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Convert an optional date to its column value
+ */
+std::int64_t toColumnDate(const std::optional<std::chrono::system_clock::time_point>& date) {
+    if (!date) {
+        return kNoDate;
+    }
+    return std::chrono::duration_cast<std::chrono::seconds>(date->time_since_epoch()).count();
+}
+
+/**
+ * @brief Convert a column value back to an optional date
+ */
+std::optional<std::chrono::system_clock::time_point> fromColumnDate(std::int64_t seconds) {
+    if (seconds == kNoDate) {
+        return std::nullopt;
+    }
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+
+/**
+ * @brief Move the last element of a column into a slot and shrink it
+ */
+template <typename T>
+void swapRemoveColumn(std::vector<T>& column, std::size_t row) {
+    if (row + 1 != column.size()) {
+        column[row] = std::move(column.back());
+    }
+    column.pop_back();
+}
+
+template <typename T>
+void swapRemoveColumn(DictionaryColumn<T>& column, std::size_t row) {
+    column.swapRemove(row);
+}
+
+// One overload per column kind; the schema picks the right one
+
+template <typename T>
+void appendValue(std::vector<T>& column, const T& value) {
+    column.push_back(value);
+}
+
+void appendValue(std::vector<std::int64_t>& column, const BookSchema::Date& date) {
+    column.push_back(toColumnDate(date));
+}
+
+template <typename T>
+void appendValue(DictionaryColumn<T>& column, const T& value) {
+    column.push(value);
+}
+
+template <typename T>
+void assignValue(std::vector<T>& column, std::size_t row, const T& value) {
+    column[row] = value;
+}
+
+void assignValue(std::vector<std::int64_t>& column, std::size_t row, const BookSchema::Date& date) {
+    column[row] = toColumnDate(date);
+}
+
+template <typename T>
+void assignValue(DictionaryColumn<T>& column, std::size_t row, const T& value) {
+    column.set(row, value);
+}
+
+template <typename T>
+void readValue(const std::vector<T>& column, std::size_t row, T& value) {
+    value = column[row];
+}
+
+void readValue(const std::vector<std::int64_t>& column, std::size_t row, BookSchema::Date& date) {
+    date = fromColumnDate(column[row]);
+}
+
+template <typename T>
+void readValue(const DictionaryColumn<T>& column, std::size_t row, T& value) {
+    value = column.get(row);
+}
+
+/**
+ * @brief The BookChunk column of each BookSchema field
+ *
+ * A schema field without an entry here fails to compile.
+ */
+template <typename Field>
+struct ChunkColumn;
+
+template <>
+struct ChunkColumn<BookSchema::IdField> {
+    static constexpr auto member = &BookChunk::ids;
+};
+
+template <>
+struct ChunkColumn<BookSchema::TitleField> {
+    static constexpr auto member = &BookChunk::titles;
+};
+
+template <>
+struct ChunkColumn<BookSchema::AuthorField> {
+    static constexpr auto member = &BookChunk::authors;
+};
+
+template <>
+struct ChunkColumn<BookSchema::IsbnField> {
+    static constexpr auto member = &BookChunk::isbns;
+};
+
+template <>
+struct ChunkColumn<BookSchema::PageCountField> {
+    static constexpr auto member = &BookChunk::pageCounts;
+};
+
+template <>
+struct ChunkColumn<BookSchema::CurrentPageField> {
+    static constexpr auto member = &BookChunk::currentPages;
+};
+
+template <>
+struct ChunkColumn<BookSchema::StartDateField> {
+    static constexpr auto member = &BookChunk::startDates;
+};
+
+template <>
+struct ChunkColumn<BookSchema::CompletionDateField> {
+    static constexpr auto member = &BookChunk::completionDates;
+};
+
+template <>
+struct ChunkColumn<BookSchema::GenreField> {
+    static constexpr auto member = &BookChunk::genres;
+};
+
+template <>
+struct ChunkColumn<BookSchema::PublisherField> {
+    static constexpr auto member = &BookChunk::publishers;
+};
+
+template <>
+struct ChunkColumn<BookSchema::YearField> {
+    static constexpr auto member = &BookChunk::years;
+};
+
+} // namespace
+
+// ==== BOOK CHUNK ====
+
+std::size_t BookChunk::size() const {
+    return ids.size();
+}
+
+/**
+ * @brief Build a Book object from one row
+ */
+Book BookChunk::getBook(std::size_t row) const {
+    Book book;
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        readValue(this->*ChunkColumn<F>::member, row, F::get(book));
+    });
+    book.m_loadedFields = kCoreBookFields; // Texts are not kept in memory
+    return book;
+}
+
+/**
+ * @brief Append a book as a new row
+ */
+void BookChunk::append(const Book& book) {
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        appendValue(this->*ChunkColumn<F>::member, F::get(book));
+    });
+    widenZones(completionDates.size() - 1);
+    if (sortKeys) {
+        titleKeys.push_back(sortKeys->makeKey(book.m_title));
+        authorKeys.push_back(sortKeys->makeKey(book.m_author));
+    }
+}
+
+/**
+ * @brief Overwrite one row with a book
+ */
+void BookChunk::assign(std::size_t row, const Book& book) {
+    if (sortKeys) {
+        // Progress updates are the common case; only rekey real renames
+        if (titles[row] != book.m_title) {
+            titleKeys[row] = sortKeys->makeKey(book.m_title);
+        }
+        if (authors[row] != book.m_author) {
+            authorKeys[row] = sortKeys->makeKey(book.m_author);
+        }
+    }
+
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        assignValue(this->*ChunkColumn<F>::member, row, F::get(book));
+    });
+    widenZones(row);
+}
+
+/**
+ * @brief Move the last row into a row, then drop the last row
+ */
+void BookChunk::swapRemove(std::size_t row) {
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        swapRemoveColumn(this->*ChunkColumn<F>::member, row);
+    });
+    if (sortKeys) {
+        swapRemoveColumn(titleKeys, row);
+        swapRemoveColumn(authorKeys, row);
+    }
+}
+
+/**
+ * @brief Recompute the zone maps exactly from the columns
+ */
+void BookChunk::refreshZones() {
+    pageCountZone = ZoneMap();
+    currentPageZone = ZoneMap();
+    startDateZone = ZoneMap();
+    completionDateZone = ZoneMap();
+    for (std::size_t row = 0; row < size(); ++row) {
+        widenZones(row);
+    }
+}
+
+/**
+ * @brief Prepare a chunk for publishing
+ */
+void BookChunk::seal() {
+    refreshZones();
+    genres.seal();
+    publishers.seal();
+    years.seal();
+    updateMemoryCharges();
+}
+
+/**
+ * @brief Recompute the memory charges from the column sizes
+ */
+void BookChunk::updateMemoryCharges() {
+    tableMemory.set(static_cast<std::int64_t>(
+        heapBytes(ids) + heapBytes(titles) + heapBytes(authors) + heapBytes(isbns) +
+        heapBytes(pageCounts) + heapBytes(currentPages) + heapBytes(startDates) +
+        heapBytes(completionDates) + genres.getMemoryUsage() + publishers.getMemoryUsage() +
+        years.getMemoryUsage()));
+    keyMemory.set(static_cast<std::int64_t>(heapBytes(titleKeys) + heapBytes(authorKeys)));
+}
+
+/**
+ * @brief Widen the zone maps to include one row
+ */
+void BookChunk::widenZones(std::size_t row) {
+    pageCountZone.add(pageCounts[row]);
+    currentPageZone.add(currentPages[row]);
+    if (startDates[row] != kNoDate) {
+        startDateZone.add(startDates[row]);
+    }
+    if (completionDates[row] != kNoDate) {
+        completionDateZone.add(completionDates[row]);
+    }
+}
+
+/**
+ * @brief Regenerate the sort key columns for another locale
+ */
+void BookChunk::rebuildSortKeys(std::shared_ptr<const SortKeyGenerator> generator) {
+    sortKeys = std::move(generator);
+    titleKeys.clear();
+    authorKeys.clear();
+    if (!sortKeys) {
+        titleKeys.shrink_to_fit();
+        authorKeys.shrink_to_fit();
+        updateMemoryCharges();
+        return;
+    }
+
+    titleKeys.reserve(size());
+    authorKeys.reserve(size());
+    for (std::size_t row = 0; row < size(); ++row) {
+        titleKeys.push_back(sortKeys->makeKey(titles[row]));
+        authorKeys.push_back(sortKeys->makeKey(authors[row]));
+    }
+    updateMemoryCharges();
+}
+
+// ==== BOOK TABLE SNAPSHOT ====
+
+BookTableSnapshot::BookTableSnapshot(std::vector<std::shared_ptr<const BookChunk>> chunks,
+                                     std::uint64_t version)
+    : m_chunks(std::move(chunks))
+    , m_version(version)
+    , m_size(0)
+{
+    for (const auto& chunk : m_chunks) {
+        m_size += chunk->size();
+    }
+}
+
+std::size_t BookTableSnapshot::size() const {
+    return m_size;
+}
+
+std::size_t BookTableSnapshot::getChunkCount() const {
+    return m_chunks.size();
+}
+
+const BookChunk& BookTableSnapshot::getChunk(std::size_t index) const {
+    return *m_chunks[index];
+}
+
+const std::shared_ptr<const BookChunk>& BookTableSnapshot::getChunkPointer(std::size_t index) const {
+    return m_chunks[index];
+}
+
+std::uint64_t BookTableSnapshot::getVersion() const {
+    return m_version;
+}
+
+/**
+ * @brief Build every book in the snapshot
+ */
+std::vector<Book> BookTableSnapshot::toBooks() const {
+    std::vector<Book> books;
+    books.reserve(m_size);
+    for (const auto& chunk : m_chunks) {
+        for (std::size_t row = 0; row < chunk->size(); ++row) {
+            books.push_back(chunk->getBook(row));
+        }
+    }
+    return books;
+}
+
+// ==== BOOK TABLE ====
+
+/**
+ * @brief Constructor - creates an empty table
+ */
+BookTable::BookTable()
+    : m_current(std::make_shared<const BookTableSnapshot>(
+          std::vector<std::shared_ptr<const BookChunk>>(), 0))
+    , m_nextVersion(1)
+    , m_memoryReclaimer(0)
+{
+    // Key columns are the one part of the table that can go: collated
+    // orders fall back to byte order and the database still has the keys
+    m_memoryReclaimer = MemoryAccounting::global().addReclaimer(
+        MemorySubsystem::SortKeys, [this](std::int64_t) {
+            if (getSortKeyGenerator()) {
+                setSortKeyGenerator(nullptr);
+            }
+        });
+}
+
+/**
+ * @brief Destructor - unregisters the memory reclaimer
+ */
+BookTable::~BookTable() {
+    MemoryAccounting::global().removeReclaimer(m_memoryReclaimer);
+}
+
+/**
+ * @brief Get the current version of the table
+ *
+ * The atomic load is the only synchronization a reader does.
+ */
+std::shared_ptr<const BookTableSnapshot> BookTable::snapshot() const {
+    return std::atomic_load(&m_current);
+}
+
+/**
+ * @brief Find a book in the current version
+ *
+ * Takes the writer lock because the ID index belongs to the writers.
+ */
+std::optional<Book> BookTable::findBook(int id) const {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+    auto found = m_index.find(id);
+    if (found == m_index.end()) {
+        return std::nullopt;
+    }
+    std::shared_ptr<const BookTableSnapshot> current = std::atomic_load(&m_current);
+    return current->getChunk(found->second.chunk).getBook(found->second.row);
+}
+
+/**
+ * @brief Replace the whole table
+ */
+void BookTable::load(const std::vector<Book>& books) {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+
+    std::vector<std::shared_ptr<const BookChunk>> chunks;
+    for (std::size_t start = 0; start < books.size(); start += kBookChunkCapacity) {
+        auto chunk = std::make_shared<BookChunk>();
+        chunk->sortKeys = m_sortKeys;
+        std::size_t end = std::min(books.size(), start + kBookChunkCapacity);
+        for (std::size_t i = start; i < end; ++i) {
+            chunk->append(books[i]);
+        }
+        chunk->seal();
+        chunks.push_back(std::move(chunk));
+    }
+
+    rebuildIndex(chunks);
+    publish(std::move(chunks));
+    lock.unlock();
+    MemoryAccounting::global().enforceBudgets(); // Reclaimers may write to the table
+}
+
+/**
+ * @brief Insert or update books and remove others in one version
+ */
+std::shared_ptr<const BookTableSnapshot> BookTable::apply(const std::vector<Book>& changed,
+                                                          const std::vector<int>& removed) {
+    return write(changed, removed, false);
+}
+
+/**
+ * @brief Overwrite only the loaded fields of existing books
+ */
+std::shared_ptr<const BookTableSnapshot> BookTable::merge(const std::vector<Book>& partial) {
+    return write(partial, {}, true);
+}
+
+/**
+ * @brief Shared body of apply() and merge()
+ *
+ * When merging, each book's loaded fields are copied onto the row as it
+ * is now, under the writer lock, and books not in the table are skipped.
+ */
+std::shared_ptr<const BookTableSnapshot> BookTable::write(const std::vector<Book>& changed,
+                                                          const std::vector<int>& removed,
+                                                          bool mergeFields) {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+
+    std::shared_ptr<const BookTableSnapshot> current = std::atomic_load(&m_current);
+    std::vector<std::shared_ptr<const BookChunk>> chunks;
+    for (std::size_t i = 0; i < current->getChunkCount(); ++i) {
+        chunks.push_back(current->getChunkPointer(i));
+    }
+
+    // Private copies of the chunks this change touches (copy-on-write)
+    std::vector<std::shared_ptr<BookChunk>> copies(chunks.size());
+    auto writable = [&](std::size_t index) -> BookChunk& {
+        if (!copies[index]) {
+            copies[index] = std::make_shared<BookChunk>(*chunks[index]);
+        }
+        return *copies[index];
+    };
+
+    bool emptiedChunk = false;
+    for (int id : removed) {
+        auto found = m_index.find(id);
+        if (found == m_index.end()) {
+            continue;
+        }
+        Location location = found->second;
+        m_index.erase(found);
+
+        BookChunk& chunk = writable(location.chunk);
+        int movedId = chunk.ids.back();
+        chunk.swapRemove(location.row);
+        if (movedId != id) {
+            m_index[movedId] = location;
+        }
+        emptiedChunk = emptiedChunk || chunk.size() == 0;
+    }
+
+    for (const Book& book : changed) {
+        auto found = m_index.find(book.getId());
+        if (found != m_index.end()) {
+            BookChunk& chunk = writable(found->second.chunk);
+            if (mergeFields) {
+                Book merged = chunk.getBook(found->second.row);
+                merged.copyFieldsFrom(book, book.getLoadedFields() & ~toMask(BookField::Id));
+                chunk.assign(found->second.row, merged);
+            } else {
+                chunk.assign(found->second.row, book);
+            }
+            continue;
+        }
+        if (mergeFields) {
+            continue; // deleted since the caller read it
+        }
+
+        // New book: append to the last chunk, or start a new one
+        if (chunks.empty() || (copies.back() ? copies.back()->size()
+                                             : chunks.back()->size()) >= kBookChunkCapacity) {
+            chunks.push_back(nullptr);
+            copies.push_back(std::make_shared<BookChunk>());
+            copies.back()->sortKeys = m_sortKeys;
+        }
+        std::size_t last = chunks.size() - 1;
+        BookChunk& chunk = writable(last);
+        chunk.append(book);
+        m_index[book.getId()] = Location{ last, chunk.size() - 1 };
+    }
+
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        if (copies[i]) {
+            copies[i]->seal(); // Removals and updates may have narrowed the zone maps
+            chunks[i] = std::move(copies[i]);
+        }
+    }
+
+    if (emptiedChunk) {
+        // Dropping chunks shifts chunk indices, so the index must follow
+        chunks.erase(std::remove_if(chunks.begin(), chunks.end(),
+                                    [](const auto& chunk) { return chunk->size() == 0; }),
+                     chunks.end());
+        rebuildIndex(chunks);
+    }
+
+    std::shared_ptr<const BookTableSnapshot> published = publish(std::move(chunks));
+    lock.unlock();
+    MemoryAccounting::global().enforceBudgets(); // Reclaimers may write to the table
+    return published;
+}
+
+/**
+ * @brief Insert or update a single book
+ */
+void BookTable::upsert(const Book& book) {
+    apply({ book });
+}
+
+/**
+ * @brief Remove a single book
+ */
+bool BookTable::remove(int id) {
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (m_index.find(id) == m_index.end()) {
+            return false;
+        }
+    }
+    apply({}, { id });
+    return true;
+}
+
+/**
+ * @brief Publish a snapshot built elsewhere
+ */
+std::shared_ptr<const BookTableSnapshot> BookTable::restore(const BookTableSnapshot& snapshot) {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+
+    std::vector<std::shared_ptr<const BookChunk>> chunks;
+    for (std::size_t i = 0; i < snapshot.getChunkCount(); ++i) {
+        chunks.push_back(snapshot.getChunkPointer(i));
+        if (chunks.back()->sortKeys != m_sortKeys) {
+            // Taken before a locale switch: bring its keys up to date
+            auto copy = std::make_shared<BookChunk>(*chunks.back());
+            copy->rebuildSortKeys(m_sortKeys);
+            chunks.back() = std::move(copy);
+        }
+    }
+
+    rebuildIndex(chunks);
+    std::shared_ptr<const BookTableSnapshot> published = publish(std::move(chunks));
+    lock.unlock();
+    MemoryAccounting::global().enforceBudgets(); // Reclaimers may write to the table
+    return published;
+}
+
+// ==== SORT KEYS ====
+
+/**
+ * @brief Switch the locale of the sort key columns
+ *
+ * Every chunk is copied and rekeyed; readers keep using the old keys
+ * until the new snapshot is published.
+ */
+std::shared_ptr<const BookTableSnapshot> BookTable::setSortKeyGenerator(
+    std::shared_ptr<const SortKeyGenerator> generator) {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    m_sortKeys = std::move(generator);
+
+    std::shared_ptr<const BookTableSnapshot> current = std::atomic_load(&m_current);
+    std::vector<std::shared_ptr<const BookChunk>> chunks;
+    for (std::size_t i = 0; i < current->getChunkCount(); ++i) {
+        auto copy = std::make_shared<BookChunk>(current->getChunk(i));
+        copy->rebuildSortKeys(m_sortKeys);
+        chunks.push_back(std::move(copy));
+    }
+    std::shared_ptr<const BookTableSnapshot> published = publish(std::move(chunks));
+    lock.unlock();
+    MemoryAccounting::global().enforceBudgets(); // Reclaimers may write to the table
+    return published;
+}
+
+/**
+ * @brief Get the generator used for the sort key columns
+ */
+std::shared_ptr<const SortKeyGenerator> BookTable::getSortKeyGenerator() const {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    return m_sortKeys;
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Rebuild the ID index from a list of chunks
+ */
+void BookTable::rebuildIndex(const std::vector<std::shared_ptr<const BookChunk>>& chunks) {
+    m_index.clear();
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+        for (std::size_t row = 0; row < chunks[c]->size(); ++row) {
+            m_index[chunks[c]->ids[row]] = Location{ c, row };
+        }
+    }
+}
+
+/**
+ * @brief Swap in a new snapshot built from the given chunks
+ */
+std::shared_ptr<const BookTableSnapshot> BookTable::publish(
+    std::vector<std::shared_ptr<const BookChunk>> chunks) {
+    auto next = std::make_shared<const BookTableSnapshot>(std::move(chunks), m_nextVersion++);
+    std::atomic_store(&m_current, next);
+    return next;
+}
@@ -0,0 +1,373 @@
+/**
+ * @file book_top_k.cpp
+ * @brief Implementation of the top-K queries for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "book_top_k.h"
+#include "parallel.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+/// Rows scored per block; small enough for the scratch arrays to stay in L1
+constexpr std::size_t kBlockSize = 256;
+
+/// Rank key of a row that does not take part in the query
+constexpr std::int64_t kExcluded = std::numeric_limits<std::int64_t>::min();
+
+/**
+ * @brief A row competing for the top K
+ *
+ * The rank key is the score, negated when the query wants the smallest
+ * values, so "better" always means a larger key.
+ */
+struct Candidate {
+    std::int64_t key;
+    int id;
+    std::uint32_t chunk;
+    std::uint32_t row;
+};
+
+/**
+ * @brief Strict "a ranks before b": larger key, then lower ID
+ */
+bool ranksBefore(const Candidate& a, const Candidate& b) {
+    return a.key != b.key ? a.key > b.key : a.id < b.id;
+}
+
+/**
+ * @brief Metric value of one row (kExcluded if the metric is unset)
+ */
+template <TopKMetric Metric>
+inline std::int64_t metricValue(int pageCount, int currentPage,
+                                std::int64_t startDate, std::int64_t completionDate) {
+    switch (Metric) {
+        case TopKMetric::PageCount:      return pageCount;
+        case TopKMetric::CurrentPage:    return currentPage;
+        case TopKMetric::PagesLeft:      return std::int64_t(pageCount) - currentPage;
+        case TopKMetric::StartDate:      return startDate;
+        case TopKMetric::CompletionDate: return completionDate;
+    }
+    return kExcluded;
+}
+
+/**
+ * @brief Rank keys for rows [begin, end) of a chunk
+ *
+ * One loop per metric (the template argument), with no branches on the
+ * row data, so the compiler can vectorize it.
+ */
+template <TopKMetric Metric>
+void fillKeys(const BookChunk& chunk, std::size_t begin, std::size_t end,
+              const TopKQuery& query, std::int64_t* keys) {
+    const int* pageCounts = chunk.pageCounts.data();
+    const int* currentPages = chunk.currentPages.data();
+    const std::int64_t* startDates = chunk.startDates.data();
+    const std::int64_t* completionDates = chunk.completionDates.data();
+    const std::int64_t sign = query.largest ? 1 : -1;
+
+    for (std::size_t i = begin; i < end; ++i) {
+        std::int64_t value = metricValue<Metric>(pageCounts[i], currentPages[i],
+                                                 startDates[i], completionDates[i]);
+        bool keep = value != kNoDate &&
+                    isInState(query.state, pageCounts[i], currentPages[i], completionDates[i]);
+        keys[i - begin] = keep ? value * sign : kExcluded;
+    }
+}
+
+/**
+ * @brief Pick the fillKeys() instantiation for a query
+ */
+void fillKeys(const BookChunk& chunk, std::size_t begin, std::size_t end,
+              const TopKQuery& query, std::int64_t* keys) {
+    switch (query.metric) {
+        case TopKMetric::PageCount:
+            fillKeys<TopKMetric::PageCount>(chunk, begin, end, query, keys);
+            break;
+        case TopKMetric::CurrentPage:
+            fillKeys<TopKMetric::CurrentPage>(chunk, begin, end, query, keys);
+            break;
+        case TopKMetric::PagesLeft:
+            fillKeys<TopKMetric::PagesLeft>(chunk, begin, end, query, keys);
+            break;
+        case TopKMetric::StartDate:
+            fillKeys<TopKMetric::StartDate>(chunk, begin, end, query, keys);
+            break;
+        case TopKMetric::CompletionDate:
+            fillKeys<TopKMetric::CompletionDate>(chunk, begin, end, query, keys);
+            break;
+    }
+}
+
+/**
+ * @brief A bounded heap holding the best K candidates seen so far
+ *
+ * The worst kept candidate sits on top, so its key is the threshold a
+ * new row must reach.
+ */
+class TopKHeap {
+    public:
+        explicit TopKHeap(std::size_t k) : m_k(k) { m_heap.reserve(k); }
+
+        /**
+         * @brief Key a row must reach to be considered (ties included)
+         */
+        std::int64_t threshold() const {
+            return m_heap.size() < m_k ? kExcluded + 1 : m_heap.front().key;
+        }
+
+        void offer(const Candidate& candidate) {
+            if (m_heap.size() < m_k) {
+                m_heap.push_back(candidate);
+                std::push_heap(m_heap.begin(), m_heap.end(), ranksBefore);
+            } else if (ranksBefore(candidate, m_heap.front())) {
+                std::pop_heap(m_heap.begin(), m_heap.end(), ranksBefore);
+                m_heap.back() = candidate;
+                std::push_heap(m_heap.begin(), m_heap.end(), ranksBefore);
+            }
+        }
+
+        std::vector<Candidate>& items() { return m_heap; }
+
+    private:
+        std::size_t m_k;
+        std::vector<Candidate> m_heap;
+};
+
+/**
+ * @brief Offer every qualifying row of one chunk to a heap
+ */
+void scanChunk(const BookChunk& chunk, std::uint32_t chunkIndex,
+               const TopKQuery& query, TopKHeap& heap) {
+    // Skip the chunk if even its best value (from the zone map) cannot
+    // reach the current threshold
+    const ZoneMap* zone = nullptr;
+    switch (query.metric) {
+        case TopKMetric::PageCount:      zone = &chunk.pageCountZone; break;
+        case TopKMetric::CurrentPage:    zone = &chunk.currentPageZone; break;
+        case TopKMetric::StartDate:      zone = &chunk.startDateZone; break;
+        case TopKMetric::CompletionDate: zone = &chunk.completionDateZone; break;
+        case TopKMetric::PagesLeft:      break;
+    }
+    if (zone) {
+        if (zone->min > zone->max) {
+            return; // No row has a value
+        }
+        const std::int64_t bestKey = query.largest ? zone->max : -zone->min;
+        if (bestKey < heap.threshold()) {
+            return;
+        }
+    }
+
+    std::int64_t keys[kBlockSize];
+    std::uint32_t passing[kBlockSize];
+
+    for (std::size_t begin = 0; begin < chunk.size(); begin += kBlockSize) {
+        const std::size_t end = std::min(chunk.size(), begin + kBlockSize);
+        const std::size_t count = end - begin;
+        fillKeys(chunk, begin, end, query, keys);
+
+        // Threshold filter: write every index, advance only past keepers.
+        // Branch-free, so once the heap is full almost all rows cost one
+        // compare and no mispredicted branch
+        const std::int64_t threshold = heap.threshold();
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            passing[kept] = static_cast<std::uint32_t>(i);
+            kept += keys[i] >= threshold;
+        }
+
+        for (std::size_t j = 0; j < kept; ++j) {
+            const std::size_t row = begin + passing[j];
+            heap.offer(Candidate{ keys[passing[j]], chunk.ids[row], chunkIndex,
+                                  static_cast<std::uint32_t>(row) });
+        }
+    }
+}
+
+/**
+ * @brief Order two result entries like ranksBefore()
+ */
+bool entryRanksBefore(const TopKEntry& a, const TopKEntry& b, bool largest) {
+    if (a.score != b.score) {
+        return largest ? a.score > b.score : a.score < b.score;
+    }
+    return a.book.getId() < b.book.getId();
+}
+
+/**
+ * @brief Convert an optional date to the column representation
+ */
+std::int64_t columnDate(const std::optional<std::chrono::system_clock::time_point>& date) {
+    if (!date) {
+        return kNoDate;
+    }
+    return std::chrono::duration_cast<std::chrono::seconds>(date->time_since_epoch()).count();
+}
+
+} // namespace
+
+/**
+ * @brief Find the best K books of a snapshot
+ *
+ * Every worker fills its own heap from the chunks it picks up; the heaps
+ * are merged at the end, which costs O(workers * K).
+ */
+std::vector<TopKEntry> topBooks(const BookTableSnapshot& snapshot, const TopKQuery& query) {
+    std::vector<TopKEntry> result;
+    if (query.k == 0) {
+        return result;
+    }
+
+    const std::size_t chunkCount = snapshot.getChunkCount();
+    std::vector<TopKHeap> heaps(getWorkerCount(chunkCount), TopKHeap(query.k));
+    parallelFor(chunkCount, [&](std::size_t worker, std::size_t chunk) {
+        scanChunk(snapshot.getChunk(chunk), static_cast<std::uint32_t>(chunk), query, heaps[worker]);
+    });
+
+    std::vector<Candidate> merged;
+    for (TopKHeap& heap : heaps) {
+        merged.insert(merged.end(), heap.items().begin(), heap.items().end());
+    }
+    const std::size_t count = std::min(query.k, merged.size());
+    std::partial_sort(merged.begin(), merged.begin() + count, merged.end(), ranksBefore);
+
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Candidate& candidate = merged[i];
+        result.push_back(TopKEntry{ query.largest ? candidate.key : -candidate.key,
+                                    snapshot.getChunk(candidate.chunk).getBook(candidate.row) });
+    }
+    return result;
+}
+
+/**
+ * @brief Score of a book for a query
+ *
+ * Must agree with fillKeys(), so that TopKTracker ranks changed books
+ * exactly like a rescan would.
+ */
+bool scoreBook(const Book& book, const TopKQuery& query, std::int64_t& score) {
+    const std::int64_t startDate = columnDate(book.getStartDate());
+    const std::int64_t completionDate = columnDate(book.getCompletionDate());
+    if (!isInState(query.state, book.getPageCount(), book.getCurrentPage(), completionDate)) {
+        return false;
+    }
+
+    switch (query.metric) {
+        case TopKMetric::PageCount:      score = book.getPageCount(); break;
+        case TopKMetric::CurrentPage:    score = book.getCurrentPage(); break;
+        case TopKMetric::PagesLeft:      score = std::int64_t(book.getPageCount()) - book.getCurrentPage(); break;
+        case TopKMetric::StartDate:      score = startDate; break;
+        case TopKMetric::CompletionDate: score = completionDate; break;
+    }
+    return score != kNoDate;
+}
+
+// ==== TOP-K TRACKER ====
+
+/**
+ * @brief Constructor - tracks one query
+ */
+TopKTracker::TopKTracker(const TopKQuery& query)
+    : m_query(query)
+    , m_stale(true)
+{
+}
+
+/**
+ * @brief Get the current result, rescanning only if it is stale
+ */
+const std::vector<TopKEntry>& TopKTracker::refresh(const BookTableSnapshot& snapshot) {
+    if (m_stale) {
+        m_entries = topBooks(snapshot, m_query);
+        m_stale = false;
+    }
+    return m_entries;
+}
+
+/**
+ * @brief Fold changes that were applied to the table into the result
+ */
+void TopKTracker::onBooksChanged(const std::vector<Book>& changed, const std::vector<int>& removed) {
+    if (m_stale) {
+        return; // The next refresh() rescans anyway
+    }
+
+    for (int id : removed) {
+        auto found = std::find_if(m_entries.begin(), m_entries.end(),
+                                  [id](const TopKEntry& entry) { return entry.book.getId() == id; });
+        if (found == m_entries.end()) {
+            continue;
+        }
+        if (m_entries.size() == m_query.k) {
+            m_stale = true; // The next best book is unknown
+            return;
+        }
+        m_entries.erase(found); // The list holds every qualifying book
+    }
+
+    for (const Book& book : changed) {
+        if (!applyChange(book)) {
+            m_stale = true;
+            return;
+        }
+    }
+}
+
+bool TopKTracker::isStale() const {
+    return m_stale;
+}
+
+const TopKQuery& TopKTracker::getQuery() const {
+    return m_query;
+}
+
+/**
+ * @brief Apply one changed book; false if a rescan is needed
+ *
+ * When the list is not full it holds every qualifying book, so any
+ * change can be applied directly. When it is full, a ranked book that
+ * got worse (or left) might have been overtaken by an unranked one.
+ */
+bool TopKTracker::applyChange(const Book& book) {
+    const bool largest = m_query.largest;
+    const bool full = m_entries.size() == m_query.k;
+
+    std::int64_t score = 0;
+    const bool qualifies = scoreBook(book, m_query, score);
+    TopKEntry entry{ score, book };
+
+    auto found = std::find_if(m_entries.begin(), m_entries.end(), [&](const TopKEntry& existing) {
+        return existing.book.getId() == book.getId();
+    });
+
+    if (found != m_entries.end()) {
+        if (!qualifies || entryRanksBefore(*found, entry, largest)) {
+            if (full) {
+                return false;
+            }
+            m_entries.erase(found);
+        } else {
+            m_entries.erase(found); // Same or better: re-insert below
+        }
+    } else if (!qualifies || (full && !entryRanksBefore(entry, m_entries.back(), largest))) {
+        return true; // Still outside the top K
+    }
+
+    if (qualifies) {
+        auto position = std::upper_bound(m_entries.begin(), m_entries.end(), entry,
+            [largest](const TopKEntry& a, const TopKEntry& b) {
+                return entryRanksBefore(a, b, largest);
+            });
+        m_entries.insert(position, std::move(entry));
+        if (m_entries.size() > m_query.k) {
+            m_entries.pop_back();
+        }
+    }
+    return true;
+}
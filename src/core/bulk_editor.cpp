@@ -0,0 +1,162 @@
+/**
+ * @file bulk_editor.cpp
+ * @brief Implementation of the BulkEditor class for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "bulk_editor.h"
+#include "book_schema.h"
+#include "book_table.h"
+#include "database.h"
+#include "edit_history.h"
+#include <unordered_map>
+
+// ==== CONSTRUCTOR ====
+
+BulkEditor::BulkEditor(Database& database, BookTable& table)
+    : m_database(database)
+    , m_table(table)
+    , m_history(nullptr)
+    , m_listener(nullptr)
+{
+}
+
+void BulkEditor::setHistory(EditHistory* history) {
+    m_history = history;
+}
+
+void BulkEditor::setListener(Listener listener) {
+    m_listener = std::move(listener);
+}
+
+// ==== OPERATIONS ====
+
+/**
+ * @brief Reset reading progress (move books back to "To Read")
+ */
+BulkEditResult BulkEditor::resetProgress(const std::vector<int>& ids) {
+    std::vector<std::pair<int, int>> values;
+    values.reserve(ids.size());
+    for (int id : ids) {
+        values.emplace_back(id, 0);
+    }
+
+    return run("Reset progress of " + std::to_string(ids.size()) + " books", values,
+               [](int, int) { return true; },
+               [](Book& book, int) { book.resetProgress(); });
+}
+
+/**
+ * @brief Mark books as completed
+ */
+BulkEditResult BulkEditor::markAsCompleted(const std::vector<int>& ids) {
+    std::vector<std::pair<int, int>> values;
+    values.reserve(ids.size());
+    for (int id : ids) {
+        values.emplace_back(id, 0);
+    }
+
+    return run("Mark " + std::to_string(ids.size()) + " books as completed", values,
+               [](int pageCount, int) { return pageCount > 0; },
+               [](Book& book, int) {
+                   if (!book.isCompleted()) {
+                       book.markAsCompleted(); // keeps the real date of finished books
+                   }
+               });
+}
+
+/**
+ * @brief Set page counts (for example from catalog data)
+ */
+BulkEditResult BulkEditor::setPageCounts(const std::vector<std::pair<int, int>>& pageCounts) {
+    return run("Set page count of " + std::to_string(pageCounts.size()) + " books", pageCounts,
+               [](int, int pageCount) { return BookSchema::PageCountField::isValid(pageCount); },
+               [](Book& book, int pageCount) { book.setPageCount(pageCount); });
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Scan the table and apply an edit to the selected rows
+ *
+ * Validation reads the page count column directly, so rejected rows
+ * never become Book objects. Accepted rows are built once, edited with
+ * the regular Book methods (already validated, so they cannot throw) and
+ * diffed to find the columns that actually changed.
+ */
+template <typename Accept, typename Edit>
+BulkEditResult BulkEditor::run(const std::string& description,
+                               const std::vector<std::pair<int, int>>& values,
+                               Accept accept, Edit edit) {
+    BulkEditResult result;
+
+    std::unordered_map<int, int> selected;
+    selected.reserve(values.size());
+    for (const auto& value : values) {
+        selected[value.first] = value.second;
+    }
+
+    // ==== Pass 1: validate and edit in memory ====
+
+    std::vector<Book> before;
+    std::vector<Book> after;
+    std::shared_ptr<const BookTableSnapshot> snapshot = m_table.snapshot();
+    for (std::size_t c = 0; c < snapshot->getChunkCount() && !selected.empty(); ++c) {
+        const BookChunk& chunk = snapshot->getChunk(c);
+        for (std::size_t row = 0; row < chunk.size(); ++row) {
+            auto found = selected.find(chunk.ids[row]);
+            if (found == selected.end()) {
+                continue;
+            }
+
+            if (accept(chunk.pageCounts[row], found->second)) {
+                Book book = chunk.getBook(row);
+                before.push_back(book);
+                edit(book, found->second);
+                after.push_back(std::move(book));
+            } else {
+                result.rejectedIds.push_back(chunk.ids[row]);
+            }
+            selected.erase(found);
+        }
+    }
+
+    // Whatever is left was not found in the table
+    for (const auto& missing : selected) {
+        result.rejectedIds.push_back(missing.first);
+    }
+
+    // ==== Pass 2: write only what changed, all at once ====
+
+    EditCommand command = EditHistory::makeCommand(description, before, after);
+
+    BookChangeEvent event;
+    event.description = description;
+    std::vector<Book> partialBooks;
+    partialBooks.reserve(command.changes.size());
+    for (const BookChange& change : command.changes) {
+        partialBooks.push_back(change.after);
+        event.bookIds.push_back(change.after.getId());
+        event.fields |= change.after.getLoadedFields() & ~toMask(BookField::Id);
+    }
+
+    if (!m_database.updateBooks(partialBooks)) {
+        result.error = m_database.getLastError();
+        return result;
+    }
+
+    // Only the edited fields: rows may have been updated since pass 1
+    m_table.merge(partialBooks);
+    if (m_history) {
+        m_history->record(std::move(command));
+    }
+
+    result.success = true;
+    result.changedIds = event.bookIds;
+    if (m_listener && !event.bookIds.empty()) {
+        m_listener(event);
+    }
+    return result;
+}
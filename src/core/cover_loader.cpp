@@ -0,0 +1,411 @@
+/**
+ * @file cover_loader.cpp
+ * @brief Implementation of the CoverLoader class for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "cover_loader.h"
+#include "cover_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+
+/// Queue ranks: all visible previews, then visible full images, then the same for nearby covers
+constexpr int kRankVisiblePreview = 0;
+constexpr int kRankNearbyPreview = 2;
+
+// ==== EXIF PARSING ====
+
+/**
+ * @brief Bounds-checked reader of a TIFF structure (EXIF data is one)
+ */
+class TiffReader {
+    public:
+        TiffReader(const unsigned char* data, std::size_t size)
+            : m_data(data)
+            , m_size(size)
+            , m_bigEndian(size >= 2 && data[0] == 'M')
+        {
+        }
+
+        bool isValid() const {
+            return m_size >= 8 &&
+                   ((m_data[0] == 'I' && m_data[1] == 'I') || (m_data[0] == 'M' && m_data[1] == 'M')) &&
+                   read16(2) == 42;
+        }
+
+        std::size_t size() const { return m_size; }
+
+        std::uint32_t read16(std::size_t offset) const {
+            if (offset + 2 > m_size) {
+                return 0;
+            }
+            const unsigned char* p = m_data + offset;
+            return m_bigEndian ? (p[0] << 8) | p[1] : (p[1] << 8) | p[0];
+        }
+
+        std::uint32_t read32(std::size_t offset) const {
+            if (offset + 4 > m_size) {
+                return 0;
+            }
+            const std::uint32_t high = read16(offset + (m_bigEndian ? 0 : 2));
+            const std::uint32_t low = read16(offset + (m_bigEndian ? 2 : 0));
+            return (high << 16) | low;
+        }
+
+        /**
+         * @brief Offset of the IFD following the one at `ifd` (0 if none)
+         */
+        std::uint32_t nextIfd(std::uint32_t ifd) const {
+            return read32(ifd + 2 + read16(ifd) * 12);
+        }
+
+        /**
+         * @brief Value of a SHORT or LONG tag in an IFD (0 if absent)
+         */
+        std::uint32_t findTag(std::uint32_t ifd, std::uint16_t tag) const {
+            const std::uint32_t count = read16(ifd);
+            for (std::uint32_t i = 0; i < count; ++i) {
+                const std::size_t entry = ifd + 2 + i * 12;
+                if (entry + 12 > m_size) {
+                    break;
+                }
+                if (read16(entry) == tag) {
+                    return read16(entry + 2) == 3 ? read16(entry + 8) : read32(entry + 8);
+                }
+            }
+            return 0;
+        }
+
+    private:
+        const unsigned char* m_data;
+        std::size_t m_size;
+        bool m_bigEndian;
+};
+
+/// IFD1 tags locating the JPEG thumbnail
+constexpr std::uint16_t kTagThumbnailOffset = 0x0201;
+constexpr std::uint16_t kTagThumbnailLength = 0x0202;
+
+} // namespace
+
+/**
+ * @brief Extract the thumbnail embedded in a JPEG's EXIF data
+ *
+ * Walks the JPEG segments up to the image data looking for the EXIF
+ * APP1 segment; the thumbnail location is in its second IFD.
+ */
+std::optional<std::string> extractEmbeddedPreview(const std::string& encoded) {
+    const auto* data = reinterpret_cast<const unsigned char*>(encoded.data());
+    const std::size_t size = encoded.size();
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return std::nullopt; // not a JPEG
+    }
+
+    std::size_t pos = 2;
+    while (pos + 4 <= size && data[pos] == 0xFF) {
+        const unsigned char marker = data[pos + 1];
+        if (marker == 0xDA || marker == 0xD9) {
+            break; // image data starts: no more metadata
+        }
+        const std::size_t length = (data[pos + 2] << 8) | data[pos + 3];
+        if (length < 2 || pos + 2 + length > size) {
+            break;
+        }
+
+        const unsigned char* body = data + pos + 4;
+        const std::size_t bodySize = length - 2;
+        if (marker == 0xE1 && bodySize > 6 && std::memcmp(body, "Exif\0\0", 6) == 0) {
+            TiffReader tiff(body + 6, bodySize - 6);
+            if (!tiff.isValid()) {
+                return std::nullopt;
+            }
+            const std::uint32_t ifd1 = tiff.nextIfd(tiff.read32(4));
+            if (ifd1 == 0) {
+                return std::nullopt;
+            }
+            const std::uint32_t offset = tiff.findTag(ifd1, kTagThumbnailOffset);
+            const std::uint32_t length = tiff.findTag(ifd1, kTagThumbnailLength);
+            if (offset == 0 || length < 4 || std::size_t(offset) + length > tiff.size()) {
+                return std::nullopt;
+            }
+            const unsigned char* thumbnail = body + 6 + offset;
+            if (thumbnail[0] != 0xFF || thumbnail[1] != 0xD8) {
+                return std::nullopt; // uncompressed thumbnails are not supported
+            }
+            return std::string(reinterpret_cast<const char*>(thumbnail), length);
+        }
+        pos += 2 + length;
+    }
+    return std::nullopt;
+}
+
+// ==== CONSTRUCTOR and DESTRUCTOR ====
+
+/**
+ * @brief Constructor - starts the decoding workers
+ */
+CoverLoader::CoverLoader(CoverStore& store, CoverDecoder decoder, int maxWidth, std::size_t workerCount)
+    : m_store(store)
+    , m_decoder(std::move(decoder))
+    , m_maxWidth(maxWidth)
+    , m_readyCallback(nullptr)
+    , m_nextGeneration(1)
+    , m_stopping(false)
+{
+    for (std::size_t i = 0; i < std::max<std::size_t>(workerCount, 1); ++i) {
+        m_workers.emplace_back(&CoverLoader::runWorker, this);
+    }
+}
+
+/**
+ * @brief Destructor - cancels everything and stops the workers
+ */
+CoverLoader::~CoverLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void CoverLoader::setReadyCallback(ReadyCallback callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_readyCallback = std::move(callback);
+}
+
+// ==== REQUESTS ====
+
+/**
+ * @brief Replace the set of wanted covers
+ */
+void CoverLoader::updateViewport(const std::vector<CoverRequest>& visible,
+                                 const std::vector<CoverRequest>& nearby) {
+    std::unordered_set<int> wanted;
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (std::size_t i = 0; i < visible.size(); ++i) {
+            if (wanted.insert(visible[i].itemId).second) {
+                want(visible[i], true, i);
+            }
+        }
+        for (std::size_t i = 0; i < nearby.size(); ++i) {
+            if (wanted.insert(nearby[i].itemId).second) {
+                want(nearby[i], false, i);
+            }
+        }
+
+        // Cancel the rest; running decodes notice the missing entry
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (wanted.count(it->first) == 0) {
+                if (it->second.queued) {
+                    m_queue.erase(makeKey(it->first, it->second));
+                }
+                it = m_entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_ready.erase(std::remove_if(m_ready.begin(), m_ready.end(),
+                                     [&](const CoverDelivery& d) { return wanted.count(d.itemId) == 0; }),
+                      m_ready.end());
+        queued = !m_queue.empty();
+    }
+    if (queued) {
+        m_wake.notify_all();
+    }
+}
+
+/**
+ * @brief Collect decoded covers for this frame
+ *
+ * A preview is dropped when the full image of the same cover is ready
+ * too (it would be replaced right away), as are images of a cover the
+ * item no longer shows.
+ */
+std::vector<CoverDelivery> CoverLoader::takeReady(std::size_t byteBudget) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unordered_set<int> full;
+    for (const CoverDelivery& delivery : m_ready) {
+        if (delivery.quality == CoverQuality::Full) {
+            full.insert(delivery.itemId);
+        }
+    }
+
+    // Most urgent first: visible before nearby, in display order
+    std::vector<std::pair<QueueKey, std::size_t>> order;
+    std::vector<bool> stale(m_ready.size(), false);
+    for (std::size_t i = 0; i < m_ready.size(); ++i) {
+        const CoverDelivery& delivery = m_ready[i];
+        auto it = m_entries.find(delivery.itemId);
+        stale[i] = it == m_entries.end() || it->second.hash != delivery.hash ||
+                   (delivery.quality == CoverQuality::Preview && full.count(delivery.itemId) != 0);
+        if (!stale[i]) {
+            order.emplace_back(QueueKey(it->second.visible ? 0 : 1, it->second.position, delivery.itemId), i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<CoverDelivery> result;
+    std::vector<bool> taken(m_ready.size(), false);
+    std::size_t bytes = 0;
+    for (const auto& [key, index] : order) {
+        const std::size_t size = m_ready[index].image.rgba.size();
+        if (!result.empty() && bytes + size > byteBudget) {
+            break;
+        }
+        bytes += size;
+        taken[index] = true;
+        result.push_back(std::move(m_ready[index]));
+    }
+
+    // Keep what did not fit; drop taken and stale deliveries
+    std::deque<CoverDelivery> rest;
+    for (std::size_t i = 0; i < m_ready.size(); ++i) {
+        if (!taken[i] && !stale[i]) {
+            rest.push_back(std::move(m_ready[i]));
+        }
+    }
+    m_ready.swap(rest);
+    return result;
+}
+
+std::size_t CoverLoader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t pending = m_ready.size();
+    for (const auto& [itemId, entry] : m_entries) {
+        pending += entry.done ? 0 : 1;
+    }
+    return pending;
+}
+
+// ==== HELPER METHODS ====
+
+CoverLoader::QueueKey CoverLoader::makeKey(int itemId, const Entry& entry) {
+    const int rank = (entry.visible ? kRankVisiblePreview : kRankNearbyPreview) +
+                     (entry.next == CoverQuality::Full ? 1 : 0);
+    return QueueKey(rank, entry.position, itemId);
+}
+
+/**
+ * @brief Add or reposition one wanted cover
+ *
+ * A cover whose hash changed starts over under a new generation, so a
+ * decode of the old image still running is discarded.
+ */
+void CoverLoader::want(const CoverRequest& request, bool visible, std::size_t position) {
+    auto it = m_entries.find(request.itemId);
+    if (it != m_entries.end() && it->second.hash == request.hash) {
+        Entry& entry = it->second;
+        if (entry.queued) {
+            m_queue.erase(makeKey(request.itemId, entry));
+        }
+        entry.visible = visible;
+        entry.position = position;
+        if (entry.queued) {
+            m_queue.insert(makeKey(request.itemId, entry));
+        }
+        return;
+    }
+
+    if (it != m_entries.end() && it->second.queued) {
+        m_queue.erase(makeKey(request.itemId, it->second));
+    }
+    Entry& entry = m_entries[request.itemId];
+    entry = Entry();
+    entry.hash = request.hash;
+    entry.visible = visible;
+    entry.position = position;
+    entry.generation = m_nextGeneration++;
+    entry.queued = true;
+    m_queue.insert(makeKey(request.itemId, entry));
+}
+
+/**
+ * @brief Body of the decoding workers
+ */
+void CoverLoader::runWorker() {
+    while (true) {
+        int itemId = 0;
+        std::string hash;
+        std::string encoded;
+        CoverQuality quality = CoverQuality::Preview;
+        std::uint64_t generation = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            itemId = std::get<2>(*m_queue.begin());
+            m_queue.erase(m_queue.begin());
+
+            Entry& entry = m_entries.at(itemId);
+            entry.queued = false;
+            hash = entry.hash;
+            quality = entry.next;
+            generation = entry.generation;
+            encoded = std::move(entry.encoded);
+        }
+
+        std::optional<CoverImage> image = decodeStage(hash, quality, encoded);
+
+        ReadyCallback ready; // copied under the lock, called outside it
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(itemId);
+            if (it == m_entries.end() || it->second.generation != generation) {
+                continue; // cancelled while decoding
+            }
+            Entry& entry = it->second;
+            if (image) {
+                m_ready.push_back(CoverDelivery{ itemId, hash, quality, std::move(*image) });
+                ready = m_readyCallback;
+            }
+            if (quality == CoverQuality::Preview && !encoded.empty()) {
+                entry.next = CoverQuality::Full;
+                entry.encoded = std::move(encoded);
+                entry.queued = true;
+                m_queue.insert(makeKey(itemId, entry));
+            } else {
+                entry.done = true; // full image decoded, or the cover is unreadable
+            }
+        }
+        if (ready) {
+            ready();
+        }
+    }
+}
+
+/**
+ * @brief Decode one stage of a cover
+ *
+ * Reads the file on the first stage and leaves it in `encoded` for the
+ * second; `encoded` stays empty if the cover cannot be read.
+ */
+std::optional<CoverImage> CoverLoader::decodeStage(const std::string& hash, CoverQuality quality,
+                                                   std::string& encoded) {
+    if (encoded.empty()) {
+        std::optional<std::string> data = m_store.read(hash);
+        if (!data || data->empty()) {
+            return std::nullopt;
+        }
+        encoded = std::move(*data);
+    }
+
+    if (quality == CoverQuality::Preview) {
+        std::optional<std::string> preview = extractEmbeddedPreview(encoded);
+        return preview ? m_decoder(*preview, m_maxWidth) : std::nullopt;
+    }
+    return m_decoder(encoded, m_maxWidth);
+}
@@ -0,0 +1,411 @@
+/**
+ * @file cover_store.cpp
+ * @brief Implementation of the CoverStore class for the Personal Reading Management System (PRMS)
+ *
+ * Uses POSIX file APIs for the atomic write (mkstemp, fsync, rename,
+ * directory fsync).
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "cover_store.h"
+#include "database.h"
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace {
+
+/// Length of a hex SHA-256
+constexpr std::size_t kHashLength = 64;
+
+// ==== SHA-256 ====
+
+constexpr std::array<std::uint32_t, 64> kRoundConstants = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline std::uint32_t rotateRight(std::uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+/**
+ * @brief Mix one 64-byte block into the hash state
+ */
+void sha256Block(std::array<std::uint32_t, 8>& state, const unsigned char* block) {
+    std::uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (std::uint32_t(block[i * 4]) << 24) | (std::uint32_t(block[i * 4 + 1]) << 16) |
+               (std::uint32_t(block[i * 4 + 2]) << 8) | std::uint32_t(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        const std::uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const std::uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i) {
+        const std::uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+        const std::uint32_t choice = (e & f) ^ (~e & g);
+        const std::uint32_t t1 = h + s1 + choice + kRoundConstants[i] + w[i];
+        const std::uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+        const std::uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        const std::uint32_t t2 = s0 + majority;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+/**
+ * @brief SHA-256 of a byte string, as lower-case hex
+ */
+std::string sha256Hex(const std::string& data) {
+    std::array<std::uint32_t, 8> state = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    const std::size_t fullBlocks = data.size() / 64;
+    for (std::size_t i = 0; i < fullBlocks; ++i) {
+        sha256Block(state, bytes + i * 64);
+    }
+
+    // Padding: 0x80, zeros, then the bit length (one or two blocks)
+    unsigned char tail[128] = {};
+    const std::size_t rest = data.size() - fullBlocks * 64;
+    std::copy(bytes + fullBlocks * 64, bytes + data.size(), tail);
+    tail[rest] = 0x80;
+    const std::size_t tailSize = rest < 56 ? 64 : 128;
+    const std::uint64_t bits = static_cast<std::uint64_t>(data.size()) * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[tailSize - 1 - i] = static_cast<unsigned char>(bits >> (i * 8));
+    }
+    for (std::size_t offset = 0; offset < tailSize; offset += 64) {
+        sha256Block(state, tail + offset);
+    }
+
+    static const char kHexDigits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(kHashLength);
+    for (std::uint32_t word : state) {
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            hex.push_back(kHexDigits[(word >> shift) & 0xF]);
+        }
+    }
+    return hex;
+}
+
+// ==== FILE HELPERS ====
+
+/**
+ * @brief Check that a string looks like a content hash
+ *
+ * Hashes become path components, so anything else is rejected.
+ */
+bool isValidHash(const std::string& hash) {
+    return hash.size() == kHashLength &&
+           hash.find_first_not_of("0123456789abcdef") == std::string::npos;
+}
+
+/**
+ * @brief Check whether a file was last modified before a cutoff
+ */
+bool isOlderThan(const std::string& path, std::chrono::seconds age) {
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    return std::time(nullptr) - info.st_mtime >= age.count();
+}
+
+/**
+ * @brief Flush a directory so entries just created or renamed in it survive a crash
+ */
+bool syncDirectory(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    int result;
+    do {
+        result = ::fsync(fd);
+    } while (result != 0 && errno == EINTR);
+    return ::close(fd) == 0 && result == 0;
+}
+
+} // namespace
+
+// ==== CONSTRUCTOR and DESTRUCTOR ====
+
+/**
+ * @brief Constructor - opens (and creates) the store
+ */
+CoverStore::CoverStore(const std::string& rootDir)
+    : m_root(rootDir)
+    , m_tempDir(rootDir + "/tmp")
+    , m_stopping(false)
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_tempDir, error);
+    if (error) {
+        throw std::runtime_error("Cannot create cover store '" + rootDir + "': " + error.message());
+    }
+}
+
+/**
+ * @brief Destructor - stops the background collector
+ */
+CoverStore::~CoverStore() {
+    stopCollector();
+}
+
+// ==== CONTENT ====
+
+std::string CoverStore::hashContent(const std::string& data) {
+    return sha256Hex(data);
+}
+
+/**
+ * @brief Get the file path of a cover (two levels of 256 shards)
+ */
+std::string CoverStore::getPath(const std::string& hash) const {
+    return m_root + "/" + hash.substr(0, 2) + "/" + hash.substr(2, 2) + "/" + hash;
+}
+
+/**
+ * @brief Store an image, unless an identical one is stored already
+ */
+std::optional<std::string> CoverStore::put(const std::string& data) {
+    std::string hash = hashContent(data);
+    const std::string path = getPath(hash);
+    if (::access(path.c_str(), F_OK) == 0) {
+        return hash; // same bytes, same name: nothing to write
+    }
+    if (!writeAtomically(path, data)) {
+        return std::nullopt;
+    }
+    return hash;
+}
+
+/**
+ * @brief Read a cover
+ */
+std::optional<std::string> CoverStore::read(const std::string& hash) const {
+    if (!isValidHash(hash)) {
+        return std::nullopt;
+    }
+    std::ifstream file(getPath(hash), std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// ==== BOOK COVERS ====
+
+/**
+ * @brief Store an image and make it a book's cover
+ *
+ * Holding m_mutex across both steps keeps the collector from deleting
+ * the file of an unreferenced cover that is just being reused.
+ */
+std::optional<std::string> CoverStore::setBookCover(Database& database, int bookId, const std::string& data) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::optional<std::string> hash = put(data);
+    if (!hash || !database.setBookCover(bookId, *hash, static_cast<std::int64_t>(data.size()))) {
+        return std::nullopt;
+    }
+    return hash;
+}
+
+bool CoverStore::clearBookCover(Database& database, int bookId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return database.setBookCover(bookId, "", 0);
+}
+
+// ==== GARBAGE COLLECTION ====
+
+/**
+ * @brief Delete covers no book has used for a while
+ *
+ * The record goes first: if deleting the file then fails, the file is
+ * merely an orphan for the next sweep, never a record without a file.
+ */
+CoverCollection CoverStore::collectGarbage(Database& database, std::chrono::seconds gracePeriod,
+                                           bool sweepOrphans) {
+    CoverCollection result;
+    const auto cutoff = std::chrono::system_clock::now() - gracePeriod;
+    for (const std::string& hash : database.findUnreferencedCovers(cutoff)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (database.deleteUnreferencedCover(hash)) {
+            if (isValidHash(hash)) {
+                ::unlink(getPath(hash).c_str());
+            }
+            ++result.covers;
+        }
+    }
+
+    result.tempFiles = removeStaleTempFiles(gracePeriod);
+    if (sweepOrphans) {
+        result.orphans = removeOrphans(database, gracePeriod);
+    }
+    return result;
+}
+
+/**
+ * @brief Run collectGarbage() periodically on a background thread
+ */
+void CoverStore::startCollector(const std::string& dbPath, std::chrono::seconds interval,
+                                std::chrono::seconds gracePeriod) {
+    if (m_collector.joinable()) {
+        return;
+    }
+
+    // Open on the caller's thread so a bad path is reported right away
+    auto database = std::make_shared<Database>(dbPath);
+    m_stopping = false;
+    m_collector = std::thread([this, database, interval, gracePeriod]() {
+        std::unique_lock<std::mutex> lock(m_collectorMutex);
+        while (!m_collectorWake.wait_for(lock, interval, [this]() { return m_stopping; })) {
+            lock.unlock();
+            collectGarbage(*database, gracePeriod);
+            lock.lock();
+        }
+    });
+}
+
+/**
+ * @brief Stop the background collector and wait for it to exit
+ */
+void CoverStore::stopCollector() {
+    {
+        std::lock_guard<std::mutex> lock(m_collectorMutex);
+        m_stopping = true;
+    }
+    m_collectorWake.notify_all();
+    if (m_collector.joinable()) {
+        m_collector.join();
+    }
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Write a file atomically (temporary file, fsync, rename)
+ *
+ * The temporary file lives inside the store, so the rename never
+ * crosses file systems. The shard directory is synced after the rename,
+ * and its parents up to the store root when the shard is new, so the file is durable
+ * before the database records it.
+ */
+bool CoverStore::writeAtomically(const std::string& path, const std::string& data) {
+    const std::filesystem::path shard = std::filesystem::path(path).parent_path();
+    std::error_code error;
+    const bool newShard = std::filesystem::create_directories(shard, error);
+    if (error) {
+        return false;
+    }
+
+    std::string tempPath = m_tempDir + "/cover-XXXXXX";
+    const int fd = ::mkstemp(&tempPath[0]);
+    if (fd < 0) {
+        return false;
+    }
+    ::fchmod(fd, 0644);
+
+    bool ok = true;
+    std::size_t written = 0;
+    while (ok && written < data.size()) {
+        const ssize_t count = ::write(fd, data.data() + written, data.size() - written);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        ok = count > 0;
+        written += ok ? static_cast<std::size_t>(count) : 0;
+    }
+    ok = ok && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+
+    // rename() replaces an identical file written concurrently, harmlessly
+    if (!ok || ::rename(tempPath.c_str(), path.c_str()) != 0) {
+        ::unlink(tempPath.c_str());
+        return false;
+    }
+    return syncDirectory(shard.string()) &&
+           (!newShard || (syncDirectory(shard.parent_path().string()) && syncDirectory(m_root)));
+}
+
+/**
+ * @brief Delete temporary files older than the grace period
+ *
+ * They are left by writes interrupted by a crash. Young ones may belong
+ * to a write in progress.
+ */
+std::size_t CoverStore::removeStaleTempFiles(std::chrono::seconds gracePeriod) {
+    std::size_t removed = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_tempDir, error)) {
+        const std::string path = entry.path().string();
+        if (isOlderThan(path, gracePeriod) && ::unlink(path.c_str()) == 0) {
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+/**
+ * @brief Delete cover files the database does not know
+ *
+ * Young files are skipped: they may have been written by put() and not
+ * referenced yet.
+ */
+std::size_t CoverStore::removeOrphans(Database& database, std::chrono::seconds gracePeriod) {
+    std::vector<std::string> orphans;
+    std::error_code error;
+    for (const auto& shard : std::filesystem::directory_iterator(m_root, error)) {
+        const std::string name = shard.path().filename().string();
+        if (name.size() != 2 || !shard.is_directory()) {
+            continue; // skips tmp/
+        }
+        std::error_code innerError;
+        for (const auto& file : std::filesystem::recursive_directory_iterator(shard.path(), innerError)) {
+            const std::string hash = file.path().filename().string();
+            if (file.is_regular_file() && isValidHash(hash)) {
+                orphans.push_back(hash);
+            }
+        }
+    }
+
+    std::size_t removed = 0;
+    for (const std::string& hash : orphans) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::string path = getPath(hash);
+        if (!database.hasCover(hash) && isOlderThan(path, gracePeriod) && ::unlink(path.c_str()) == 0) {
+            ++removed;
+        }
+    }
+    return removed;
+}
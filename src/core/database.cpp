@@ -0,0 +1,1171 @@
+/**
+ * @file database.cpp
+ * @brief Implementation of the Database class for the Personal Reading Management System (PRMS)
+ *
+ * This file contains the SQLite3 code behind the Database class:
+ * connection handling, schema creation and Book CRUD operations.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "database.h"
+#include "book_schema.h"
+#include <stdexcept>
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+/**
+ * @brief Owns a prepared statement and finalizes it when leaving scope
+ */
+struct Statement {
+    sqlite3_stmt* handle = nullptr;
+
+    Statement(sqlite3* db, const std::string& sql) {
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &handle, nullptr) != SQLITE_OK) {
+            handle = nullptr;
+        }
+    }
+
+    ~Statement() {
+        sqlite3_finalize(handle);
+    }
+
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+};
+
+/**
+ * @brief Convert a time point to seconds since the epoch for storage
+ */
+sqlite3_int64 toSeconds(const std::chrono::system_clock::time_point& time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+/**
+ * @brief Convert stored seconds since the epoch back to a time point
+ */
+std::chrono::system_clock::time_point fromSeconds(sqlite3_int64 seconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+
+/// Drops a book's reference to its cover (parameter 1: book ID)
+const char* const kReleaseCoverSql =
+    "UPDATE covers SET refcount = refcount - 1,"
+    " unreferenced_since = CASE WHEN refcount = 1 THEN strftime('%s', 'now')"
+    "                      ELSE unreferenced_since END"
+    " WHERE hash = (SELECT hash FROM book_covers WHERE book_id = ?1);";
+
+// ==== VALUE BINDERS AND READERS ====
+// One overload per BookSchema value type; the schema picks the right one
+// at compile time.
+
+void bindValue(sqlite3_stmt* stmt, int index, int value) {
+    sqlite3_bind_int(stmt, index, value);
+}
+
+void bindValue(sqlite3_stmt* stmt, int index, const std::string& value) {
+    sqlite3_bind_text(stmt, index, value.c_str(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+}
+
+/**
+ * @brief Bind an optional date, using NULL when it is not set
+ */
+void bindValue(sqlite3_stmt* stmt, int index, const BookSchema::Date& date) {
+    if (date) {
+        sqlite3_bind_int64(stmt, index, toSeconds(*date));
+    } else {
+        sqlite3_bind_null(stmt, index);
+    }
+}
+
+void readValue(sqlite3_stmt* stmt, int column, int& value) {
+    value = sqlite3_column_int(stmt, column);
+}
+
+/**
+ * @brief Read a text column, treating NULL as an empty string
+ */
+void readValue(sqlite3_stmt* stmt, int column, std::string& value) {
+    const unsigned char* text = sqlite3_column_text(stmt, column);
+    if (text == nullptr) {
+        value.clear();
+        return;
+    }
+    value.assign(reinterpret_cast<const char*>(text),
+                 static_cast<std::size_t>(sqlite3_column_bytes(stmt, column)));
+}
+
+/**
+ * @brief Read an optional date, treating NULL as "not set"
+ */
+void readValue(sqlite3_stmt* stmt, int column, BookSchema::Date& date) {
+    if (sqlite3_column_type(stmt, column) == SQLITE_NULL) {
+        date = std::nullopt;
+    } else {
+        date = fromSeconds(sqlite3_column_int64(stmt, column));
+    }
+}
+
+/**
+ * @brief Read a review or notes body in chunks from a connection
+ *
+ * Shared by Database::streamText() and the loaders of deferred texts,
+ * which hold their own reference to the connection.
+ *
+ * @return True if the text was read (or there was none)
+ */
+bool streamTextFrom(sqlite3* db, int bookId, BookTextKind kind,
+                    const std::function<bool(const char* data, std::size_t size)>& sink,
+                    std::size_t chunkSize) {
+    // Look up the rowid first so the body itself is read through blob I/O
+    Statement stmt(db, "SELECT rowid FROM book_texts WHERE book_id = ? AND kind = ?;");
+    if (!stmt.handle) {
+        return false;
+    }
+    sqlite3_bind_int(stmt.handle, 1, bookId);
+    sqlite3_bind_int(stmt.handle, 2, static_cast<int>(kind));
+
+    int result = sqlite3_step(stmt.handle);
+    if (result == SQLITE_DONE) {
+        return true; // No text stored
+    }
+    if (result != SQLITE_ROW) {
+        return false;
+    }
+    sqlite3_int64 rowid = sqlite3_column_int64(stmt.handle, 0);
+
+    sqlite3_blob* blob = nullptr;
+    if (sqlite3_blob_open(db, "main", "book_texts", "body", rowid, 0, &blob) != SQLITE_OK) {
+        sqlite3_blob_close(blob);
+        return false;
+    }
+
+    const int total = sqlite3_blob_bytes(blob);
+    std::string buffer(std::min<std::size_t>(chunkSize, static_cast<std::size_t>(total)), '\0');
+    bool ok = true;
+    for (int offset = 0; offset < total; ) {
+        int length = std::min(static_cast<int>(buffer.size()), total - offset);
+        if (sqlite3_blob_read(blob, &buffer[0], length, offset) != SQLITE_OK) {
+            ok = false;
+            break;
+        }
+        if (!sink(buffer.data(), static_cast<std::size_t>(length))) {
+            break; // Caller has seen enough
+        }
+        offset += length;
+    }
+
+    sqlite3_blob_close(blob);
+    return ok;
+}
+
+/**
+ * @brief Read a whole text body (empty if there is none or on error)
+ */
+std::string readTextFrom(sqlite3* db, int bookId, BookTextKind kind) {
+    std::string body;
+    streamTextFrom(db, bookId, kind, [&body](const char* data, std::size_t size) {
+        body.append(data, size);
+        return true;
+    }, 64 * 1024);
+    return body;
+}
+
+/**
+ * @brief Bind the fields in a mask to consecutive parameters
+ * @return Index of the next free parameter
+ */
+int bindFields(sqlite3_stmt* stmt, const Book& book, BookFieldMask fields, int index) {
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        if (fields & F::bit) {
+            bindValue(stmt, index++, F::get(book));
+        }
+    });
+    return index;
+}
+
+} // namespace
+
+// ==== CONSTRUCTOR and DESTRUCTOR ====
+
+/**
+ * @brief Constructor - opens the database connection
+ * @param dbPath Path to the SQLite database file
+ *
+ * The connection is opened in serialized mode, so deferred texts may
+ * read through it from any thread.
+ */
+Database::Database(const std::string& dbPath)
+    : m_db(nullptr)
+    , m_lastError("")
+{
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX;
+    if (sqlite3_open_v2(dbPath.c_str(), &m_db, flags, nullptr) != SQLITE_OK) {
+        std::string message = m_db ? sqlite3_errmsg(m_db) : "out of memory";
+        sqlite3_close(m_db);
+        m_db = nullptr;
+        throw std::runtime_error("Cannot open database '" + dbPath + "': " + message);
+    }
+    m_connection.reset(m_db, sqlite3_close_v2);
+    // Background connections (log tailer, cover collector) hold the write
+    // lock only briefly; wait for them instead of failing with SQLITE_BUSY
+    sqlite3_busy_timeout(m_db, 5000);
+}
+
+/**
+ * @brief Destructor - releases the database connection
+ *
+ * The connection closes once the last deferred text that still refers
+ * to it is gone.
+ */
+Database::~Database() {
+    m_connection.reset();
+}
+
+// ==== DATABASE INITIALIZATION ====
+
+/**
+ * @brief Create the schema if it does not exist yet
+ * @return True on success
+ */
+bool Database::initialize() {
+    bool created = execute(
+        BookSchema::createTableSql("books") +
+        // Long texts live in their own table so book rows stay small
+        "CREATE TABLE IF NOT EXISTS book_texts ("
+        " book_id INTEGER NOT NULL,"
+        " kind INTEGER NOT NULL,"
+        " body BLOB NOT NULL,"
+        " PRIMARY KEY (book_id, kind)"
+        ");"
+        "CREATE TABLE IF NOT EXISTS reading_events ("
+        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        " book_id INTEGER NOT NULL,"
+        " page INTEGER NOT NULL,"
+        " timestamp INTEGER NOT NULL"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_reading_events_book"
+        " ON reading_events (book_id, timestamp);"
+        // Collated sort keys of the current locale; SQLite compares BLOBs
+        // with memcmp, so these indexes give locale-correct ORDER BY
+        "CREATE TABLE IF NOT EXISTS book_sort_keys ("
+        " book_id INTEGER PRIMARY KEY,"
+        " locale TEXT NOT NULL,"
+        " title_key BLOB NOT NULL,"
+        " author_key BLOB NOT NULL"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_book_sort_keys_title"
+        " ON book_sort_keys (title_key, author_key);"
+        "CREATE INDEX IF NOT EXISTS idx_book_sort_keys_author"
+        " ON book_sort_keys (author_key, title_key);"
+        // Content-addressed covers: one row per distinct image
+        "CREATE TABLE IF NOT EXISTS covers ("
+        " hash TEXT PRIMARY KEY,"
+        " size INTEGER NOT NULL,"
+        " refcount INTEGER NOT NULL,"
+        " unreferenced_since INTEGER"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_covers_unreferenced"
+        " ON covers (unreferenced_since) WHERE refcount = 0;"
+        "CREATE TABLE IF NOT EXISTS book_covers ("
+        " book_id INTEGER PRIMARY KEY,"
+        " hash TEXT NOT NULL"
+        ");"
+        "CREATE TABLE IF NOT EXISTS log_checkpoints ("
+        " path TEXT PRIMARY KEY,"
+        " inode INTEGER NOT NULL,"
+        " offset INTEGER NOT NULL"
+        ");");
+    return created && addMissingColumns();
+}
+
+/**
+ * @brief Add schema fields that an older books table is missing
+ * @return True on success
+ */
+bool Database::addMissingColumns() {
+    std::vector<std::string> existing;
+    {
+        Statement stmt(m_db, "PRAGMA table_info(books);");
+        if (!stmt.handle) {
+            setError("addMissingColumns");
+            return false;
+        }
+        while (sqlite3_step(stmt.handle) == SQLITE_ROW) {
+            existing.push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt.handle, 1)));
+        }
+    }
+
+    std::string sql = BookSchema::addMissingColumnsSql("books", existing);
+    return sql.empty() || execute(sql);
+}
+
+/**
+ * @brief Check whether the connection is open
+ */
+bool Database::isOpen() const {
+    return m_db != nullptr;
+}
+
+/**
+ * @brief Get the message of the last failed operation
+ */
+const std::string& Database::getLastError() const {
+    return m_lastError;
+}
+
+// ==== TRANSACTIONS ====
+
+bool Database::beginTransaction() {
+    return execute("BEGIN TRANSACTION;");
+}
+
+bool Database::commitTransaction() {
+    return execute("COMMIT;");
+}
+
+bool Database::rollbackTransaction() {
+    return execute("ROLLBACK;");
+}
+
+// ==== BOOK OPERATIONS ====
+
+/**
+ * @brief The last prepared UPDATE of a batch and the fields it sets
+ */
+struct Database::UpdateCache {
+    std::unique_ptr<Statement> stmt;
+    BookFieldMask fields = 0;
+};
+
+/**
+ * @brief Save a new book
+ * @param book The book to save
+ * @return The new ID, or 0 on error
+ *
+ * Runs in a savepoint: the row, its sort keys and its texts are stored
+ * together or not at all.
+ */
+int Database::addBook(const Book& book) {
+    // Every core column except the ID, which SQLite assigns
+    const BookFieldMask fields = kCoreBookFields & ~toMask(BookField::Id);
+
+    std::string placeholders;
+    for (std::size_t i = 1; i < BookSchema::Fields::count; ++i) {
+        placeholders += i == 1 ? "?" : ", ?";
+    }
+
+    if (!execute("SAVEPOINT add_book;")) {
+        return 0;
+    }
+
+    int id = 0;
+    {
+        Statement stmt(m_db, "INSERT INTO books (" + BookSchema::columnList(fields) +
+                             ") VALUES (" + placeholders + ");");
+        if (stmt.handle) {
+            bindFields(stmt.handle, book, fields, 1);
+            if (sqlite3_step(stmt.handle) == SQLITE_DONE) {
+                id = static_cast<int>(sqlite3_last_insert_rowid(m_db));
+            }
+        }
+        if (id == 0) {
+            setError("addBook");
+        }
+    }
+    bool ok = id != 0 && saveSortKeys(id, book, fields);
+
+    // Only texts that were given a body in memory need to be written
+    if (ok && book.m_review.isLoaded() && !book.m_review.get().empty()) {
+        ok = saveText(id, BookTextKind::Review, book.m_review.get());
+    }
+    if (ok && book.m_notes.isLoaded() && !book.m_notes.get().empty()) {
+        ok = saveText(id, BookTextKind::Notes, book.m_notes.get());
+    }
+
+    if (!ok) {
+        execute("ROLLBACK TO add_book; RELEASE add_book;");
+        return 0;
+    }
+    return execute("RELEASE add_book;") ? id : 0;
+}
+
+/**
+ * @brief Update the loaded fields of an existing book
+ * @param book The book to update (matched by ID)
+ * @return True if a row was updated
+ *
+ * Runs in a savepoint. The row is written first, so texts and sort keys
+ * are only stored for a book that exists.
+ */
+bool Database::updateBook(const Book& book) {
+    if (!execute("SAVEPOINT update_book;")) {
+        return false;
+    }
+
+    UpdateCache cache;
+    bool found = false;
+    if (!writeBook(book, cache, found) || !found) {
+        execute("ROLLBACK TO update_book; RELEASE update_book;");
+        return false;
+    }
+    return execute("RELEASE update_book;");
+}
+
+/**
+ * @brief Update many books in one transaction
+ * @param books The books to update (matched by ID)
+ * @return True if every update succeeded
+ */
+bool Database::updateBooks(const std::vector<Book>& books) {
+    if (!beginTransaction()) {
+        return false;
+    }
+
+    // Bulk edits usually change the same fields on every book, so keep
+    // the last prepared statement and only re-prepare when that changes
+    UpdateCache cache;
+
+    for (const Book& book : books) {
+        bool found = false;
+        if (!writeBook(book, cache, found)) {
+            cache.stmt.reset();
+            rollbackTransaction();
+            return false;
+        }
+    }
+
+    cache.stmt.reset(); // Finalize before committing
+    if (!commitTransaction()) {
+        rollbackTransaction();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Delete a book
+ * @param id The ID of the book to delete
+ * @return True if a row was deleted
+ *
+ * The book and the rows that hang off it, including its cover
+ * reference, are removed in one savepoint, so a failure part way
+ * leaves nothing changed.
+ */
+bool Database::deleteBook(int id) {
+    if (!execute("SAVEPOINT delete_book;")) {
+        return false;
+    }
+
+    // Remove the rows that hang off the book first
+    bool ok = true;
+    for (const char* sql : { "DELETE FROM book_texts WHERE book_id = ?;",
+                             "DELETE FROM reading_events WHERE book_id = ?;",
+                             "DELETE FROM book_sort_keys WHERE book_id = ?;",
+                             kReleaseCoverSql,
+                             "DELETE FROM book_covers WHERE book_id = ?;",
+                             "DELETE FROM books WHERE id = ?;" }) {
+        Statement stmt(m_db, sql);
+        if (!stmt.handle) {
+            ok = false;
+            break;
+        }
+        sqlite3_bind_int(stmt.handle, 1, id);
+        if (sqlite3_step(stmt.handle) != SQLITE_DONE) {
+            ok = false;
+            break;
+        }
+    }
+
+    if (!ok) {
+        setError("deleteBook");
+        execute("ROLLBACK TO delete_book; RELEASE delete_book;");
+        return false;
+    }
+    const bool deleted = sqlite3_changes(m_db) > 0; // Of the books DELETE, the last run
+    return execute("RELEASE delete_book;") && deleted;
+}
+
+/**
+ * @brief Load a single book with the given projection
+ * @param id The ID of the book to load
+ * @param fields The fields to read
+ * @return The book, or empty if not found
+ */
+std::optional<Book> Database::loadBook(int id, BookFieldMask fields) {
+    Statement stmt(m_db, "SELECT " + buildColumnList(fields) + " FROM books WHERE id = ?;");
+    if (!stmt.handle) {
+        setError("loadBook");
+        return std::nullopt;
+    }
+
+    sqlite3_bind_int(stmt.handle, 1, id);
+    int result = sqlite3_step(stmt.handle);
+    if (result == SQLITE_ROW) {
+        return readBook(stmt.handle, fields);
+    }
+    if (result != SQLITE_DONE) {
+        setError("loadBook");
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Load every book with the given projection
+ * @param fields The fields to read
+ * @return All books ordered by ID
+ */
+std::vector<Book> Database::loadAllBooks(BookFieldMask fields) {
+    std::vector<Book> books;
+
+    Statement stmt(m_db, "SELECT " + buildColumnList(fields) + " FROM books ORDER BY id;");
+    if (!stmt.handle) {
+        setError("loadAllBooks");
+        return books;
+    }
+
+    int result;
+    while ((result = sqlite3_step(stmt.handle)) == SQLITE_ROW) {
+        books.push_back(readBook(stmt.handle, fields));
+    }
+    if (result != SQLITE_DONE) {
+        setError("loadAllBooks");
+        books.clear();
+    }
+    return books;
+}
+
+/**
+ * @brief Load every book in collated order
+ * @param order Which sort keys to order by
+ * @param fields The fields to read
+ * @return All books in order
+ */
+std::vector<Book> Database::loadBooksInCollatedOrder(CollatedOrder order, BookFieldMask fields) {
+    std::vector<Book> books;
+    if (!m_sortKeys) {
+        m_lastError = "loadBooksInCollatedOrder: no sort key generator set";
+        return books;
+    }
+
+    // book_id is the rowid, so both indexes already end in it
+    const char* orderBy = order == CollatedOrder::Title
+        ? " ORDER BY title_key, author_key, book_id;"
+        : " ORDER BY author_key, title_key, book_id;";
+    Statement stmt(m_db, "SELECT " + buildColumnList(fields) +
+                         " FROM book_sort_keys JOIN books ON books.id = book_sort_keys.book_id" +
+                         orderBy);
+    if (!stmt.handle) {
+        setError("loadBooksInCollatedOrder");
+        return books;
+    }
+
+    int result;
+    while ((result = sqlite3_step(stmt.handle)) == SQLITE_ROW) {
+        books.push_back(readBook(stmt.handle, fields));
+    }
+    if (result != SQLITE_DONE) {
+        setError("loadBooksInCollatedOrder");
+        books.clear();
+    }
+    return books;
+}
+
+// ==== SORT KEYS ====
+
+/**
+ * @brief Set the locale the stored sort keys are generated for
+ * @param generator The generator (null stops maintaining keys)
+ * @return True on success
+ */
+bool Database::setSortKeyGenerator(std::shared_ptr<const SortKeyGenerator> generator) {
+    m_sortKeys = std::move(generator);
+    if (!m_sortKeys) {
+        return execute("DELETE FROM book_sort_keys;"); // Would go stale otherwise
+    }
+
+    // Keys are generated once per locale: skip the rebuild if every book
+    // already has a key for this locale
+    Statement stmt(m_db,
+        "SELECT (SELECT COUNT(*) FROM books),"
+        " COUNT(*), COALESCE(SUM(locale = ?), 0) FROM book_sort_keys;");
+    if (!stmt.handle) {
+        setError("setSortKeyGenerator");
+        return false;
+    }
+    const std::string& locale = m_sortKeys->getLocaleName();
+    sqlite3_bind_text(stmt.handle, 1, locale.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt.handle) != SQLITE_ROW) {
+        setError("setSortKeyGenerator");
+        return false;
+    }
+
+    sqlite3_int64 bookCount = sqlite3_column_int64(stmt.handle, 0);
+    sqlite3_int64 keyCount = sqlite3_column_int64(stmt.handle, 1);
+    sqlite3_int64 localeCount = sqlite3_column_int64(stmt.handle, 2);
+    if (bookCount == keyCount && keyCount == localeCount) {
+        return true;
+    }
+    return rebuildSortKeys();
+}
+
+/**
+ * @brief Regenerate the stored sort keys of every book
+ * @return True on success
+ */
+bool Database::rebuildSortKeys() {
+    if (!m_sortKeys) {
+        return execute("DELETE FROM book_sort_keys;");
+    }
+    if (!beginTransaction()) {
+        return false;
+    }
+
+    bool ok = execute("DELETE FROM book_sort_keys;");
+    {
+        Statement select(m_db, "SELECT id, title, author FROM books;");
+        Statement insert(m_db,
+            "INSERT INTO book_sort_keys (book_id, locale, title_key, author_key)"
+            " VALUES (?, ?, ?, ?);");
+        if (ok && (!select.handle || !insert.handle)) {
+            setError("rebuildSortKeys");
+            ok = false;
+        }
+
+        const std::string& locale = m_sortKeys->getLocaleName();
+        std::string title;
+        std::string author;
+        int result = SQLITE_DONE;
+        while (ok && (result = sqlite3_step(select.handle)) == SQLITE_ROW) {
+            readValue(select.handle, 1, title);
+            readValue(select.handle, 2, author);
+            std::string titleKey = m_sortKeys->makeKey(title);
+            std::string authorKey = m_sortKeys->makeKey(author);
+
+            sqlite3_bind_int(insert.handle, 1, sqlite3_column_int(select.handle, 0));
+            sqlite3_bind_text(insert.handle, 2, locale.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_blob64(insert.handle, 3, titleKey.data(), titleKey.size(), SQLITE_STATIC);
+            sqlite3_bind_blob64(insert.handle, 4, authorKey.data(), authorKey.size(), SQLITE_STATIC);
+            if (sqlite3_step(insert.handle) != SQLITE_DONE) {
+                setError("rebuildSortKeys");
+                ok = false;
+            }
+            sqlite3_reset(insert.handle);
+        }
+        if (ok && result != SQLITE_DONE) {
+            setError("rebuildSortKeys");
+            ok = false;
+        }
+    } // Finalize before committing
+
+    if (!ok || !commitTransaction()) {
+        rollbackTransaction();
+        return false;
+    }
+    return true;
+}
+
+// ==== TEXT SIDE STORAGE ====
+
+/**
+ * @brief Save a review or notes body for a book
+ * @return True on success
+ */
+bool Database::saveText(int bookId, BookTextKind kind, const std::string& body) {
+    // An empty body means "no text": drop the row instead of storing ""
+    Statement stmt(m_db, body.empty()
+        ? "DELETE FROM book_texts WHERE book_id = ? AND kind = ?;"
+        : "INSERT OR REPLACE INTO book_texts (book_id, kind, body) VALUES (?, ?, ?);");
+    if (!stmt.handle) {
+        setError("saveText");
+        return false;
+    }
+
+    sqlite3_bind_int(stmt.handle, 1, bookId);
+    sqlite3_bind_int(stmt.handle, 2, static_cast<int>(kind));
+    if (!body.empty()) {
+        sqlite3_bind_blob64(stmt.handle, 3, body.data(), body.size(), SQLITE_STATIC);
+    }
+
+    if (sqlite3_step(stmt.handle) != SQLITE_DONE) {
+        setError("saveText");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Read a whole review or notes body
+ * @return The text (empty if there is none)
+ */
+std::string Database::loadText(int bookId, BookTextKind kind) {
+    return readTextFrom(m_db, bookId, kind);
+}
+
+/**
+ * @brief Read a review or notes body in chunks
+ * @return True if the text was read (or there was none)
+ */
+bool Database::streamText(int bookId, BookTextKind kind,
+                          const std::function<bool(const char* data, std::size_t size)>& sink,
+                          std::size_t chunkSize) {
+    if (!streamTextFrom(m_db, bookId, kind, sink, chunkSize)) {
+        setError("streamText");
+        return false;
+    }
+    return true;
+}
+
+// ==== READING ACTIVITY ====
+
+/**
+ * @brief Record reading events and apply them as progress updates
+ * @param events Events in log order
+ * @return True on success
+ */
+bool Database::applyReadingEvents(const std::vector<ReadingEvent>& events) {
+    Statement insert(m_db,
+        "INSERT INTO reading_events (book_id, page, timestamp) VALUES (?, ?, ?);");
+
+    // Mirrors Book::setCurrentPage(), but stamps dates with the event time
+    Statement update(m_db,
+        "UPDATE books SET"
+        " current_page = CASE WHEN page_count > 0 AND ?1 > page_count"
+        "                THEN page_count ELSE ?1 END,"
+        " start_date = CASE WHEN ?1 > 0 THEN COALESCE(start_date, ?2)"
+        "              ELSE start_date END,"
+        " completion_date = CASE WHEN page_count > 0 AND ?1 >= page_count"
+        "                   THEN COALESCE(completion_date, ?2) ELSE completion_date END"
+        " WHERE id = ?3;");
+    if (!insert.handle || !update.handle) {
+        setError("applyReadingEvents");
+        return false;
+    }
+
+    for (const ReadingEvent& event : events) {
+        const sqlite3_int64 seconds = toSeconds(event.timestamp);
+
+        sqlite3_bind_int(insert.handle, 1, event.bookId);
+        sqlite3_bind_int(insert.handle, 2, event.page);
+        sqlite3_bind_int64(insert.handle, 3, seconds);
+
+        sqlite3_bind_int(update.handle, 1, event.page);
+        sqlite3_bind_int64(update.handle, 2, seconds);
+        sqlite3_bind_int(update.handle, 3, event.bookId);
+
+        if (sqlite3_step(insert.handle) != SQLITE_DONE ||
+            sqlite3_step(update.handle) != SQLITE_DONE) {
+            setError("applyReadingEvents");
+            return false;
+        }
+        sqlite3_reset(insert.handle);
+        sqlite3_reset(update.handle);
+    }
+    return true;
+}
+
+/**
+ * @brief Load the checkpoint of an activity log
+ * @param path The log path
+ * @return The checkpoint, or empty if the log was never read
+ */
+std::optional<LogCheckpoint> Database::loadLogCheckpoint(const std::string& path) {
+    Statement stmt(m_db, "SELECT inode, offset FROM log_checkpoints WHERE path = ?;");
+    if (!stmt.handle) {
+        setError("loadLogCheckpoint");
+        return std::nullopt;
+    }
+
+    sqlite3_bind_text(stmt.handle, 1, path.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt.handle) != SQLITE_ROW) {
+        return std::nullopt;
+    }
+
+    LogCheckpoint checkpoint;
+    checkpoint.path = path;
+    checkpoint.inode = static_cast<std::uint64_t>(sqlite3_column_int64(stmt.handle, 0));
+    checkpoint.offset = sqlite3_column_int64(stmt.handle, 1);
+    return checkpoint;
+}
+
+/**
+ * @brief Save the checkpoint of an activity log
+ * @param checkpoint The new checkpoint
+ * @return True on success
+ */
+bool Database::saveLogCheckpoint(const LogCheckpoint& checkpoint) {
+    Statement stmt(m_db,
+        "INSERT OR REPLACE INTO log_checkpoints (path, inode, offset) VALUES (?, ?, ?);");
+    if (!stmt.handle) {
+        setError("saveLogCheckpoint");
+        return false;
+    }
+
+    sqlite3_bind_text(stmt.handle, 1, checkpoint.path.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt.handle, 2, static_cast<sqlite3_int64>(checkpoint.inode));
+    sqlite3_bind_int64(stmt.handle, 3, checkpoint.offset);
+
+    if (sqlite3_step(stmt.handle) != SQLITE_DONE) {
+        setError("saveLogCheckpoint");
+        return false;
+    }
+    return true;
+}
+
+// ==== COVERS ====
+
+/**
+ * @brief Point a book at a stored cover, or clear its cover
+ *
+ * Runs in a savepoint, so the counts stay consistent whether or not the
+ * caller has a transaction open.
+ */
+bool Database::setBookCover(int bookId, const std::string& hash, std::int64_t size) {
+    std::optional<std::string> current = getBookCover(bookId);
+    if (current ? *current == hash : hash.empty()) {
+        return true;
+    }
+    if (!execute("SAVEPOINT set_book_cover;")) {
+        return false;
+    }
+
+    auto run = [&](const char* sql, bool bindHash) {
+        Statement stmt(m_db, sql);
+        if (!stmt.handle) {
+            return false;
+        }
+        sqlite3_bind_int(stmt.handle, 1, bookId);
+        if (bindHash) {
+            sqlite3_bind_text(stmt.handle, 2, hash.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt.handle, 3, size);
+        }
+        return sqlite3_step(stmt.handle) == SQLITE_DONE;
+    };
+
+    bool ok = run(kReleaseCoverSql, false);
+    if (hash.empty()) {
+        ok = ok && run("DELETE FROM book_covers WHERE book_id = ?1;", false);
+    } else {
+        ok = ok &&
+             run("INSERT INTO covers (hash, size, refcount, unreferenced_since)"
+                 " VALUES (?2, ?3, 1, NULL)"
+                 " ON CONFLICT (hash) DO UPDATE SET refcount = refcount + 1,"
+                 " unreferenced_since = NULL;", true) &&
+             run("INSERT OR REPLACE INTO book_covers (book_id, hash) VALUES (?1, ?2);", true);
+    }
+
+    if (!ok) {
+        setError("setBookCover");
+        execute("ROLLBACK TO set_book_cover; RELEASE set_book_cover;");
+        return false;
+    }
+    return execute("RELEASE set_book_cover;");
+}
+
+/**
+ * @brief Get the content hash of a book's cover
+ */
+std::optional<std::string> Database::getBookCover(int bookId) {
+    Statement stmt(m_db, "SELECT hash FROM book_covers WHERE book_id = ?;");
+    if (!stmt.handle) {
+        setError("getBookCover");
+        return std::nullopt;
+    }
+    sqlite3_bind_int(stmt.handle, 1, bookId);
+    if (sqlite3_step(stmt.handle) != SQLITE_ROW) {
+        return std::nullopt;
+    }
+    return std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.handle, 0)));
+}
+
+/**
+ * @brief Get the number of books using a cover
+ */
+int Database::getCoverRefCount(const std::string& hash) {
+    Statement stmt(m_db, "SELECT refcount FROM covers WHERE hash = ?;");
+    if (!stmt.handle) {
+        setError("getCoverRefCount");
+        return -1;
+    }
+    sqlite3_bind_text(stmt.handle, 1, hash.c_str(), -1, SQLITE_TRANSIENT);
+    int result = sqlite3_step(stmt.handle);
+    if (result == SQLITE_ROW) {
+        return sqlite3_column_int(stmt.handle, 0);
+    }
+    if (result != SQLITE_DONE) {
+        setError("getCoverRefCount");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Find covers no book has used for a while
+ */
+std::vector<std::string> Database::findUnreferencedCovers(std::chrono::system_clock::time_point before) {
+    std::vector<std::string> hashes;
+    Statement stmt(m_db, "SELECT hash FROM covers"
+                         " WHERE refcount = 0 AND unreferenced_since < ?;");
+    if (!stmt.handle) {
+        setError("findUnreferencedCovers");
+        return hashes;
+    }
+    sqlite3_bind_int64(stmt.handle, 1, toSeconds(before));
+    while (sqlite3_step(stmt.handle) == SQLITE_ROW) {
+        hashes.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt.handle, 0)));
+    }
+    return hashes;
+}
+
+/**
+ * @brief Forget a cover if it is still unreferenced
+ *
+ * The refcount check is part of the DELETE, so a cover that was
+ * referenced again since findUnreferencedCovers() is kept.
+ */
+bool Database::deleteUnreferencedCover(const std::string& hash) {
+    Statement stmt(m_db, "DELETE FROM covers WHERE hash = ? AND refcount = 0;");
+    if (!stmt.handle) {
+        setError("deleteUnreferencedCover");
+        return false;
+    }
+    sqlite3_bind_text(stmt.handle, 1, hash.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt.handle) != SQLITE_DONE) {
+        setError("deleteUnreferencedCover");
+        return false;
+    }
+    return sqlite3_changes(m_db) > 0;
+}
+
+/**
+ * @brief Check whether a cover is known
+ */
+bool Database::hasCover(const std::string& hash) {
+    Statement stmt(m_db, "SELECT 1 FROM covers WHERE hash = ?;");
+    if (!stmt.handle) {
+        setError("hasCover");
+        return true;
+    }
+    sqlite3_bind_text(stmt.handle, 1, hash.c_str(), -1, SQLITE_TRANSIENT);
+    const int result = sqlite3_step(stmt.handle);
+    if (result != SQLITE_ROW && result != SQLITE_DONE) {
+        setError("hasCover");
+        return true;
+    }
+    return result == SQLITE_ROW;
+}
+
+/**
+ * @brief Count the books in the collection
+ * @return Number of books, or -1 on error
+ */
+int Database::getBookCount() {
+    Statement stmt(m_db, "SELECT COUNT(*) FROM books;");
+    if (!stmt.handle || sqlite3_step(stmt.handle) != SQLITE_ROW) {
+        setError("getBookCount");
+        return -1;
+    }
+    return sqlite3_column_int(stmt.handle, 0);
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Execute SQL that returns no rows
+ */
+bool Database::execute(const std::string& sql) {
+    char* message = nullptr;
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &message) != SQLITE_OK) {
+        m_lastError = message ? message : "unknown error";
+        sqlite3_free(message);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Build the column list for a projection
+ *
+ * The ID is always selected so that partial books can still be
+ * written back with updateBook().
+ */
+std::string Database::buildColumnList(BookFieldMask fields) {
+    return BookSchema::columnList((fields & kCoreBookFields) | toMask(BookField::Id));
+}
+
+/**
+ * @brief Build an UPDATE statement for a set of fields
+ *
+ * Columns appear in column order, followed by the ID parameter.
+ */
+std::string Database::buildUpdateSql(BookFieldMask fields) {
+    std::string sql = "UPDATE books SET ";
+    bool first = true;
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        if (fields & F::bit) {
+            sql += first ? "" : ", ";
+            sql += F::name;
+            sql += " = ?";
+            first = false;
+        }
+    });
+    sql += " WHERE id = ?;";
+    return sql;
+}
+
+/**
+ * @brief Bind a book to a statement built by buildUpdateSql()
+ */
+void Database::bindUpdate(sqlite3_stmt* stmt, const Book& book, BookFieldMask fields) {
+    int index = bindFields(stmt, book, fields, 1);
+    sqlite3_bind_int(stmt, index, book.m_id);
+}
+
+/**
+ * @brief Fill a book from the current row of a statement
+ *
+ * Columns appear in column order, so we walk the schema and advance the
+ * column index only for projected fields.
+ */
+Book Database::readBook(sqlite3_stmt* stmt, BookFieldMask fields) {
+    fields |= toMask(BookField::Id);
+
+    Book book;
+    int column = 0;
+    BookSchema::Fields::forEach([&](auto descriptor) {
+        using F = decltype(descriptor);
+        if (fields & F::bit) {
+            readValue(stmt, column++, F::get(book));
+        }
+    });
+
+    // Texts are not read here, only a handle that reads them on first use;
+    // it shares the connection, so it stays valid after the Database is gone
+    if (fields & toMask(BookField::Review)) {
+        int id = book.m_id;
+        book.m_review = LazyText::deferred([connection = m_connection, id]() {
+            return readTextFrom(connection.get(), id, BookTextKind::Review);
+        });
+    }
+    if (fields & toMask(BookField::Notes)) {
+        int id = book.m_id;
+        book.m_notes = LazyText::deferred([connection = m_connection, id]() {
+            return readTextFrom(connection.get(), id, BookTextKind::Notes);
+        });
+    }
+
+    book.m_loadedFields = fields & kAllBookFields;
+    return book;
+}
+
+/**
+ * @brief Write the modified texts of a book to side storage
+ *
+ * Deferred texts that were never read or changed are left alone.
+ */
+bool Database::saveModifiedTexts(const Book& book) {
+    if (book.hasField(BookField::Review) && book.m_review.isModified()) {
+        if (!saveText(book.m_id, BookTextKind::Review, book.m_review.get())) {
+            return false;
+        }
+    }
+    if (book.hasField(BookField::Notes) && book.m_notes.isModified()) {
+        if (!saveText(book.m_id, BookTextKind::Notes, book.m_notes.get())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Write one book's loaded fields, then its texts and sort keys
+ */
+bool Database::writeBook(const Book& book, UpdateCache& cache, bool& found) {
+    // Skip the ID column: it is the key, never an updated value
+    const BookFieldMask fields = book.m_loadedFields & kCoreBookFields & ~toMask(BookField::Id);
+    if (fields == 0) {
+        // Only texts to write: make sure the book exists first
+        Statement stmt(m_db, "SELECT 1 FROM books WHERE id = ?;");
+        if (!stmt.handle) {
+            setError("updateBook");
+            return false;
+        }
+        sqlite3_bind_int(stmt.handle, 1, book.m_id);
+        const int result = sqlite3_step(stmt.handle);
+        if (result != SQLITE_ROW && result != SQLITE_DONE) {
+            setError("updateBook");
+            return false;
+        }
+        found = result == SQLITE_ROW;
+    } else {
+        if (!cache.stmt || cache.fields != fields) {
+            cache.stmt = std::make_unique<Statement>(m_db, buildUpdateSql(fields));
+            cache.fields = fields;
+            if (!cache.stmt->handle) {
+                setError("updateBook");
+                cache.stmt.reset();
+                return false;
+            }
+        }
+        bindUpdate(cache.stmt->handle, book, fields);
+        if (sqlite3_step(cache.stmt->handle) != SQLITE_DONE) {
+            setError("updateBook");
+            sqlite3_reset(cache.stmt->handle);
+            return false;
+        }
+        found = sqlite3_changes(m_db) > 0;
+        sqlite3_reset(cache.stmt->handle);
+    }
+    return !found || (saveModifiedTexts(book) && saveSortKeys(book.m_id, book, fields));
+}
+
+/**
+ * @brief Refresh the stored sort keys of a book after a write
+ *
+ * A partial book may hold only one of title and author; then only that
+ * key column is updated.
+ */
+bool Database::saveSortKeys(int id, const Book& book, BookFieldMask fields) {
+    const bool title = (fields & toMask(BookField::Title)) != 0;
+    const bool author = (fields & toMask(BookField::Author)) != 0;
+    if (!m_sortKeys || (!title && !author)) {
+        return true;
+    }
+
+    const std::string& locale = m_sortKeys->getLocaleName();
+    std::string titleKey = title ? m_sortKeys->makeKey(book.m_title) : std::string();
+    std::string authorKey = author ? m_sortKeys->makeKey(book.m_author) : std::string();
+
+    Statement stmt(m_db, title && author
+        ? "INSERT OR REPLACE INTO book_sort_keys (book_id, locale, title_key, author_key)"
+          " VALUES (?1, ?2, ?3, ?4);"
+        : title
+            ? "UPDATE book_sort_keys SET title_key = ?3 WHERE book_id = ?1 AND locale = ?2;"
+            : "UPDATE book_sort_keys SET author_key = ?4 WHERE book_id = ?1 AND locale = ?2;");
+    if (!stmt.handle) {
+        setError("saveSortKeys");
+        return false;
+    }
+
+    sqlite3_bind_int(stmt.handle, 1, id);
+    sqlite3_bind_text(stmt.handle, 2, locale.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_blob64(stmt.handle, 3, titleKey.data(), titleKey.size(), SQLITE_STATIC);
+    sqlite3_bind_blob64(stmt.handle, 4, authorKey.data(), authorKey.size(), SQLITE_STATIC);
+    if (sqlite3_step(stmt.handle) != SQLITE_DONE) {
+        setError("saveSortKeys");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Remember the current SQLite error message
+ */
+void Database::setError(const std::string& context) {
+    m_lastError = context + ": " + (m_db ? sqlite3_errmsg(m_db) : "database not open");
+}
@@ -0,0 +1,198 @@
+/**
+ * @file edit_history.cpp
+ * @brief Implementation of the EditHistory class for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "edit_history.h"
+#include "database.h"
+#include "book_table.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Estimated heap bytes of a (partial) book
+ *
+ * Texts only count once loaded; deferred ones hold no body yet.
+ */
+std::size_t bookBytes(const Book& book) {
+    std::size_t bytes = heapBytes(book.getTitle()) + heapBytes(book.getAuthor()) +
+                        heapBytes(book.getISBN()) + heapBytes(book.getGenre()) +
+                        heapBytes(book.getPublisher());
+    if (book.hasField(BookField::Review) && book.getReview().isLoaded()) {
+        bytes += heapBytes(book.getReview().get());
+    }
+    if (book.hasField(BookField::Notes) && book.getNotes().isLoaded()) {
+        bytes += heapBytes(book.getNotes().get());
+    }
+    return bytes;
+}
+
+/**
+ * @brief Estimated heap bytes of a command
+ */
+std::size_t commandBytes(const EditCommand& command) {
+    std::size_t bytes = heapBytes(command.description) +
+                        command.changes.capacity() * sizeof(BookChange);
+    for (const BookChange& change : command.changes) {
+        bytes += bookBytes(change.before) + bookBytes(change.after);
+    }
+    return bytes;
+}
+
+} // namespace
+
+// ==== CONSTRUCTOR ====
+
+EditHistory::EditHistory(std::size_t maxCommands)
+    : m_maxCommands(std::max<std::size_t>(maxCommands, 1))
+    , m_memory(MemorySubsystem::EditHistory)
+{
+}
+
+// ==== RECORDING ====
+
+/**
+ * @brief Build a command by comparing books before and after an edit
+ *
+ * Only the differing fields are kept, so a progress reset across a
+ * shelf costs a few integers per book rather than whole Book copies.
+ */
+EditCommand EditHistory::makeCommand(const std::string& description,
+                                     const std::vector<Book>& before,
+                                     const std::vector<Book>& after) {
+    EditCommand command;
+    command.description = description;
+
+    std::size_t count = std::min(before.size(), after.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        BookFieldMask changed = before[i].getDifferentFields(after[i]) & ~toMask(BookField::Id);
+        if (changed == 0) {
+            continue;
+        }
+        command.changes.push_back(BookChange{ Book::partialCopy(before[i], changed),
+                                              Book::partialCopy(after[i], changed) });
+    }
+    return command;
+}
+
+/**
+ * @brief Record a command that was just applied
+ */
+void EditHistory::record(EditCommand command) {
+    if (command.changes.empty()) {
+        return;
+    }
+
+    std::int64_t bytes = m_memory.get();
+    for (const EditCommand& undone : m_redoStack) {
+        bytes -= static_cast<std::int64_t>(undone.memoryBytes);
+    }
+    m_redoStack.clear();
+
+    command.memoryBytes = commandBytes(command);
+    bytes += static_cast<std::int64_t>(command.memoryBytes);
+    m_undoStack.push_back(std::move(command));
+    m_memory.set(bytes);
+    trim();
+}
+
+// ==== UNDO / REDO ====
+
+bool EditHistory::canUndo() const {
+    return !m_undoStack.empty();
+}
+
+bool EditHistory::canRedo() const {
+    return !m_redoStack.empty();
+}
+
+std::string EditHistory::getUndoDescription() const {
+    return m_undoStack.empty() ? std::string() : m_undoStack.back().description;
+}
+
+std::string EditHistory::getRedoDescription() const {
+    return m_redoStack.empty() ? std::string() : m_redoStack.back().description;
+}
+
+/**
+ * @brief Revert the most recent command
+ */
+bool EditHistory::undo(Database& database, BookTable& table) {
+    if (m_undoStack.empty() || !applyCommand(m_undoStack.back(), true, database, table)) {
+        return false;
+    }
+    m_redoStack.push_back(std::move(m_undoStack.back()));
+    m_undoStack.pop_back();
+    trim();
+    return true;
+}
+
+/**
+ * @brief Apply the most recently undone command again
+ */
+bool EditHistory::redo(Database& database, BookTable& table) {
+    if (m_redoStack.empty() || !applyCommand(m_redoStack.back(), false, database, table)) {
+        return false;
+    }
+    m_undoStack.push_back(std::move(m_redoStack.back()));
+    m_redoStack.pop_back();
+    trim();
+    return true;
+}
+
+void EditHistory::clear() {
+    m_undoStack.clear();
+    m_redoStack.clear();
+    m_memory.set(0);
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Write one side of a command to the database and table
+ *
+ * Both are written with partial books, so only the fields the command
+ * changed are set and concurrent edits to other fields are kept. The
+ * database is written first, in one transaction; the table is only
+ * touched once it has committed. Books deleted since the edit are
+ * skipped by both.
+ */
+bool EditHistory::applyCommand(const EditCommand& command, bool useBefore,
+                               Database& database, BookTable& table) {
+    std::vector<Book> targets;
+    targets.reserve(command.changes.size());
+    for (const BookChange& change : command.changes) {
+        targets.push_back(useBefore ? change.before : change.after);
+    }
+
+    if (!database.updateBooks(targets)) {
+        return false;
+    }
+
+    table.merge(targets);
+    return true;
+}
+
+/**
+ * @brief Drop commands past the command limit or the memory budget
+ *
+ * Whichever stack reaches further from the present loses its far end:
+ * the oldest undo command or the redo command undone first.
+ */
+void EditHistory::trim() {
+    MemoryAccounting& accounting = MemoryAccounting::global();
+    for (;;) {
+        const std::size_t count = m_undoStack.size() + m_redoStack.size();
+        if (count <= m_maxCommands &&
+            (count <= 1 || !accounting.isOverBudget(MemorySubsystem::EditHistory))) {
+            return;
+        }
+        std::deque<EditCommand>& stack = m_redoStack.size() > m_undoStack.size() ? m_redoStack : m_undoStack;
+        m_memory.set(m_memory.get() - static_cast<std::int64_t>(stack.front().memoryBytes));
+        stack.pop_front();
+    }
+}
@@ -0,0 +1,322 @@
+/**
+ * @file factor_file.cpp
+ * @brief Implementation of the memory-mapped factor file for the Personal Reading Management System (PRMS)
+ *
+ * Uses POSIX mmap() to map the file.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "factor_file.h"
+#include "factor_support.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+/// Alignment of the vector block (a cache line)
+constexpr std::uint64_t kVectorAlignment = 64;
+
+/// Items scored per parallel task
+constexpr std::size_t kScoreBlockSize = 16384;
+
+std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+/**
+ * @brief Normalize an ISBN to the 13-digit form used as key
+ *
+ * ISBN-10s get the 978 prefix and a recomputed check digit, so a dump
+ * keyed by ISBN-10 matches a collection that stores ISBN-13s.
+ */
+std::string normalizeIsbn(const std::string& isbn) {
+    std::string digits;
+    for (char c : isbn) {
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            digits.push_back(c);
+        } else if ((c == 'X' || c == 'x') && digits.size() == 9) {
+            digits.push_back('X');
+        } else if (c != '-' && c != ' ') {
+            return "";
+        }
+    }
+    if (digits.size() == 10) {
+        digits = "978" + digits.substr(0, 9);
+        int sum = 0;
+        for (std::size_t i = 0; i < 12; ++i) {
+            sum += (digits[i] - '0') * (i % 2 == 0 ? 1 : 3);
+        }
+        digits.push_back(static_cast<char>('0' + (10 - sum % 10) % 10));
+    }
+    return digits.size() == 13 && digits.find('X') == std::string::npos ? digits : "";
+}
+
+/**
+ * @brief Write a factor file atomically
+ *
+ * Items are sorted by key so findItem() can binary search the mapping.
+ */
+bool writeFactorFile(const std::string& path, std::uint32_t rank, float globalMean,
+                     const std::vector<std::string>& keys, const std::vector<float>& vectors) {
+    if (rank == 0 || vectors.size() != keys.size() * rank) {
+        return false;
+    }
+    std::vector<std::size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+    FactorFileHeader header = {};
+    std::memcpy(header.magic, kFactorFileMagic, sizeof(header.magic));
+    header.rank = rank;
+    header.itemCount = keys.size();
+    header.globalMean = globalMean;
+    header.vectorsOffset = alignUp(sizeof(FactorFileHeader), kVectorAlignment);
+    header.keyOffsetsOffset = header.vectorsOffset + keys.size() * rank * sizeof(float);
+    header.keysOffset = header.keyOffsetsOffset + (keys.size() + 1) * sizeof(std::uint32_t);
+
+    std::vector<std::uint32_t> offsets(1, 0);
+    for (std::size_t item : order) {
+        if (keys[item].size() > std::numeric_limits<std::uint32_t>::max() - offsets.back()) {
+            return false; // key offsets are 32-bit
+        }
+        offsets.push_back(offsets.back() + static_cast<std::uint32_t>(keys[item].size()));
+    }
+    header.fileSize = header.keysOffset + offsets.back();
+
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        const std::string padding(header.vectorsOffset - sizeof(header), '\0');
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        for (std::size_t item : order) {
+            out.write(reinterpret_cast<const char*>(&vectors[item * rank]),
+                      static_cast<std::streamsize>(rank * sizeof(float)));
+        }
+        out.write(reinterpret_cast<const char*>(offsets.data()),
+                  static_cast<std::streamsize>(offsets.size() * sizeof(std::uint32_t)));
+        for (std::size_t item : order) {
+            out.write(keys[item].data(), static_cast<std::streamsize>(keys[item].size()));
+        }
+        out.close();
+        if (!out || !syncFile(tempPath)) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ==== FACTOR FILE ====
+
+/**
+ * @brief Constructor - maps a factor file
+ *
+ * Every offset in the header is checked against the file size (in a
+ * way no header value can overflow), and every key offset once here, so
+ * a truncated or foreign file is rejected instead of read out of bounds.
+ */
+FactorFile::FactorFile(const std::string& path)
+    : m_data(nullptr)
+    , m_size(0)
+    , m_header(nullptr)
+    , m_vectors(nullptr)
+    , m_keyOffsets(nullptr)
+    , m_keys(nullptr)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open factor file '" + path + "'");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FactorFileHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Factor file '" + path + "' is too small");
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m_data == MAP_FAILED) {
+        m_data = nullptr;
+        throw std::runtime_error("Cannot map factor file '" + path + "'");
+    }
+
+    const auto* bytes = static_cast<const char*>(m_data);
+    m_header = reinterpret_cast<const FactorFileHeader*>(bytes);
+    const FactorFileHeader& h = *m_header;
+    const bool valid =
+        std::memcmp(h.magic, kFactorFileMagic, sizeof(h.magic)) == 0 && h.rank > 0 &&
+        h.fileSize == m_size && h.vectorsOffset % alignof(float) == 0 &&
+        fitsIn(h.vectorsOffset, h.itemCount, std::uint64_t(h.rank) * sizeof(float), m_size) &&
+        h.vectorsOffset + h.itemCount * h.rank * sizeof(float) == h.keyOffsetsOffset &&
+        h.keyOffsetsOffset % alignof(std::uint32_t) == 0 &&
+        fitsIn(h.keyOffsetsOffset, h.itemCount + 1, sizeof(std::uint32_t), m_size) &&
+        h.keyOffsetsOffset + (h.itemCount + 1) * sizeof(std::uint32_t) == h.keysOffset;
+    if (!valid) {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+        throw std::runtime_error("Factor file '" + path + "' is malformed");
+    }
+    m_vectors = reinterpret_cast<const float*>(bytes + h.vectorsOffset);
+    m_keyOffsets = reinterpret_cast<const std::uint32_t*>(bytes + h.keyOffsetsOffset);
+    m_keys = bytes + h.keysOffset;
+    bool ordered = m_keyOffsets[0] == 0 && m_keyOffsets[h.itemCount] == m_size - h.keysOffset;
+    for (std::size_t item = 0; ordered && item < h.itemCount; ++item) {
+        ordered = m_keyOffsets[item] <= m_keyOffsets[item + 1];
+    }
+    if (!ordered) {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+        throw std::runtime_error("Factor file '" + path + "' is malformed");
+    }
+}
+
+/**
+ * @brief Destructor - unmaps the file
+ */
+FactorFile::~FactorFile() {
+    if (m_data) {
+        ::munmap(m_data, m_size);
+    }
+}
+
+std::uint32_t FactorFile::getRank() const {
+    return m_header->rank;
+}
+
+std::size_t FactorFile::getItemCount() const {
+    return static_cast<std::size_t>(m_header->itemCount);
+}
+
+float FactorFile::getGlobalMean() const {
+    return m_header->globalMean;
+}
+
+std::string FactorFile::getKey(std::size_t item) const {
+    return std::string(m_keys + m_keyOffsets[item], m_keyOffsets[item + 1] - m_keyOffsets[item]);
+}
+
+/**
+ * @brief Find an item by key (binary search over the sorted keys)
+ */
+std::int64_t FactorFile::findItem(const std::string& key) const {
+    std::size_t low = 0;
+    std::size_t high = getItemCount();
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        const std::uint32_t begin = m_keyOffsets[middle];
+        const std::size_t length = m_keyOffsets[middle + 1] - begin;
+        const int order = key.compare(0, std::string::npos, m_keys + begin, length);
+        if (order == 0) {
+            return static_cast<std::int64_t>(middle);
+        }
+        if (order < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return -1;
+}
+
+const float* FactorFile::getVector(std::size_t item) const {
+    return m_vectors + item * m_header->rank;
+}
+
+// ==== SCORING ====
+
+std::vector<std::uint32_t> findCompletedItems(const FactorFile& factors, const std::vector<Book>& history) {
+    std::vector<std::uint32_t> items;
+    for (const Book& book : history) {
+        if (!book.isCompleted()) {
+            continue;
+        }
+        const std::string key = normalizeIsbn(book.getISBN());
+        const std::int64_t item = key.empty() ? -1 : factors.findItem(key);
+        if (item >= 0) {
+            items.push_back(static_cast<std::uint32_t>(item));
+        }
+    }
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+    return items;
+}
+
+std::vector<float> buildProfile(const FactorFile& factors, const std::vector<std::uint32_t>& items) {
+    const std::uint32_t rank = factors.getRank();
+    std::vector<float> profile(rank, 0.0f);
+    for (std::uint32_t item : items) {
+        const float* vector = factors.getVector(item);
+        for (std::uint32_t d = 0; d < rank; ++d) {
+            profile[d] += vector[d];
+        }
+    }
+    if (!items.empty()) {
+        for (float& value : profile) {
+            value /= static_cast<float>(items.size());
+        }
+    }
+    return profile;
+}
+
+/**
+ * @brief Best items for a profile
+ *
+ * Blocks of the catalog are scored in parallel, each worker keeping its
+ * own k-sized heap; the heaps are merged at the end.
+ */
+std::vector<ItemScore> scoreItems(const FactorFile& factors, const std::vector<float>& profile,
+                                  std::size_t k, const std::vector<std::uint32_t>& exclude) {
+    const std::size_t count = factors.getItemCount();
+    const std::uint32_t rank = factors.getRank();
+    if (k == 0 || profile.size() != rank) {
+        return {};
+    }
+    const std::unordered_set<std::uint32_t> excluded(exclude.begin(), exclude.end());
+
+    const std::size_t blocks = (count + kScoreBlockSize - 1) / kScoreBlockSize;
+    std::vector<std::vector<ItemScore>> heaps(getWorkerCount(blocks));
+    parallelFor(blocks, [&](std::size_t worker, std::size_t block) {
+        const std::size_t end = std::min(count, (block + 1) * kScoreBlockSize);
+        for (std::size_t item = block * kScoreBlockSize; item < end; ++item) {
+            const float* vector = factors.getVector(item);
+            float score = 0.0f;
+            for (std::uint32_t d = 0; d < rank; ++d) {
+                score += vector[d] * profile[d];
+            }
+            if (excluded.count(static_cast<std::uint32_t>(item)) == 0) {
+                offer(heaps[worker], k, ItemScore{ static_cast<std::uint32_t>(item), score });
+            }
+        }
+    });
+
+    std::vector<ItemScore> best;
+    for (const std::vector<ItemScore>& heap : heaps) {
+        for (const ItemScore& score : heap) {
+            offer(best, k, score);
+        }
+    }
+    std::sort(best.begin(), best.end(), isBetter);
+    return best;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file factor_support.cpp
+ * @brief Implementation of the internal factor file helpers for the Personal Reading Management System (PRMS)
+ *
+ * Uses POSIX open()/fsync().
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "factor_support.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @brief Flush a written file to disk (before it is renamed into place)
+ */
+bool syncFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    int result = ::fsync(fd);
+    while (result != 0 && errno == EINTR) {
+        result = ::fsync(fd);
+    }
+    return ::close(fd) == 0 && result == 0;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file goal_planner.cpp
+ * @brief Implementation of the GoalPlanner class for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "goal_planner.h"
+#include <algorithm>
+
+namespace {
+
+/// Minutes below this are rounding noise, not reading
+constexpr double kMinuteEpsilon = 1e-6;
+
+/**
+ * @brief Weekday of a day since the epoch, Monday = 0 (the epoch was a Thursday)
+ */
+std::size_t weekdayOf(std::int64_t day) {
+    return static_cast<std::size_t>(((day + 3) % 7 + 7) % 7);
+}
+
+} // namespace
+
+double ReadingCalendar::getMinutes(std::int64_t day) const {
+    auto it = exceptions.find(day);
+    return std::max(it != exceptions.end() ? it->second : weeklyMinutes[weekdayOf(day)], 0.0);
+}
+
+// ==== CONSTRUCTOR ====
+
+GoalPlanner::GoalPlanner()
+    : m_startDay(0)
+    , m_capacityPrefix(1, 0.0)
+{
+}
+
+// ==== SOLVING ====
+
+/**
+ * @brief Plan from scratch
+ *
+ * Goals are turned into deadlines first: for each goal, in date order,
+ * the shortest unfinished books without a deadline make up whatever the
+ * books already due by then leave missing.
+ */
+void GoalPlanner::solve(const ReadingCalendar& calendar, const std::vector<PlannedBook>& books,
+                        const std::vector<ReadingGoal>& goals, std::int64_t startDay,
+                        std::size_t horizonDays) {
+    m_startDay = startDay;
+    m_capacityPrefix.assign(1, 0.0);
+    m_capacityPrefix.reserve(horizonDays + 1);
+    for (std::size_t d = 0; d < horizonDays; ++d) {
+        m_capacityPrefix.push_back(m_capacityPrefix.back() + calendar.getMinutes(startDay + static_cast<std::int64_t>(d)));
+    }
+
+    std::vector<PlannedBook> planned = books;
+    for (PlannedBook& book : planned) {
+        book.minutesLeft = std::max(book.minutesLeft, 0.0);
+    }
+
+    // Goals become deadlines of the shortest free books
+    std::vector<ReadingGoal> sortedGoals = goals;
+    std::sort(sortedGoals.begin(), sortedGoals.end(),
+              [](const ReadingGoal& a, const ReadingGoal& b) { return a.byDay < b.byDay; });
+    std::vector<std::size_t> free;
+    for (std::size_t i = 0; i < planned.size(); ++i) {
+        if (!planned[i].deadline && planned[i].minutesLeft > kMinuteEpsilon) {
+            free.push_back(i);
+        }
+    }
+    std::sort(free.begin(), free.end(), [&](std::size_t a, std::size_t b) {
+        return planned[a].minutesLeft < planned[b].minutesLeft;
+    });
+    std::size_t nextFree = 0;
+    for (const ReadingGoal& goal : sortedGoals) {
+        int due = 0;
+        for (const PlannedBook& book : planned) {
+            due += book.deadline && *book.deadline <= goal.byDay && book.minutesLeft > kMinuteEpsilon;
+        }
+        for (; due < goal.books && nextFree < free.size(); ++due) {
+            planned[free[nextFree++]].deadline = goal.byDay;
+        }
+    }
+
+    // Earliest deadline first, then the best priority per minute
+    std::stable_sort(planned.begin(), planned.end(), [](const PlannedBook& a, const PlannedBook& b) {
+        if (a.deadline.has_value() != b.deadline.has_value()) {
+            return a.deadline.has_value();
+        }
+        if (a.deadline && *a.deadline != *b.deadline) {
+            return *a.deadline < *b.deadline;
+        }
+        const double densityA = a.priority / std::max(a.minutesLeft, 1.0);
+        const double densityB = b.priority / std::max(b.minutesLeft, 1.0);
+        return densityA > densityB;
+    });
+
+    m_order = std::move(planned);
+    m_minutes.assign(m_order.size(), 0.0);
+    m_tree.assign(m_order.size() + 1, 0.0);
+    m_positions.clear();
+    for (std::size_t p = 0; p < m_order.size(); ++p) {
+        m_positions[m_order[p].bookId] = p;
+        m_minutes[p] = m_order[p].minutesLeft;
+        m_tree[p + 1] += m_minutes[p];
+        const std::size_t parent = (p + 1) + ((p + 1) & (~(p + 1) + 1));
+        if (parent < m_tree.size()) {
+            m_tree[parent] += m_tree[p + 1]; // linear-time Fenwick build
+        }
+    }
+}
+
+/**
+ * @brief Record progress on a book without solving again
+ */
+bool GoalPlanner::updateProgress(int bookId, double minutesLeft) {
+    auto it = m_positions.find(bookId);
+    if (it == m_positions.end()) {
+        return false;
+    }
+    const std::size_t position = it->second;
+    minutesLeft = std::max(minutesLeft, 0.0);
+    addBookMinutes(position, minutesLeft - m_minutes[position]);
+    m_minutes[position] = minutesLeft;
+    m_order[position].minutesLeft = minutesLeft;
+    return true;
+}
+
+// ==== RESULTS ====
+
+/**
+ * @brief Reading planned for a day
+ *
+ * The day's time is the range [available before it, available through
+ * it) on the minute axis; the books overlapping that range share it.
+ */
+std::vector<PlanAllocation> GoalPlanner::getDayPlan(std::int64_t day) const {
+    std::vector<PlanAllocation> plan;
+    const std::int64_t index = day - m_startDay;
+    if (index < 0 || index + 1 >= static_cast<std::int64_t>(m_capacityPrefix.size())) {
+        return plan;
+    }
+    const double low = m_capacityPrefix[index];
+    const double high = m_capacityPrefix[index + 1];
+
+    std::size_t position = findBookAt(low);
+    double start = getBookPrefix(position);
+    for (; position < m_order.size() && start < high; ++position) {
+        const double end = start + m_minutes[position];
+        const double minutes = std::min(end, high) - std::max(start, low);
+        if (minutes > kMinuteEpsilon) {
+            plan.push_back(PlanAllocation{ m_order[position].bookId, minutes });
+        }
+        start = end;
+    }
+    return plan;
+}
+
+double GoalPlanner::getDailyGoal(std::int64_t day) const {
+    const std::int64_t index = day - m_startDay;
+    if (index < 0 || index + 1 >= static_cast<std::int64_t>(m_capacityPrefix.size())) {
+        return 0.0;
+    }
+    const double total = getBookPrefix(m_order.size());
+    return std::clamp(total - m_capacityPrefix[index], 0.0,
+                      m_capacityPrefix[index + 1] - m_capacityPrefix[index]);
+}
+
+double GoalPlanner::getWeeklyGoal(std::int64_t firstDay) const {
+    double minutes = 0.0;
+    for (std::int64_t day = firstDay; day < firstDay + 7; ++day) {
+        minutes += getDailyGoal(day);
+    }
+    return minutes;
+}
+
+std::int64_t GoalPlanner::getFinishDay(int bookId) const {
+    auto it = m_positions.find(bookId);
+    if (it == m_positions.end()) {
+        return kNotScheduled;
+    }
+    if (m_minutes[it->second] <= kMinuteEpsilon) {
+        return m_startDay; // already finished
+    }
+    const std::int64_t index = findDayAt(getBookPrefix(it->second + 1));
+    return index == kNotScheduled ? kNotScheduled : m_startDay + index;
+}
+
+std::vector<int> GoalPlanner::getMissedDeadlines() const {
+    std::vector<int> missed;
+    double end = 0.0;
+    for (std::size_t p = 0; p < m_order.size(); ++p) {
+        end += m_minutes[p];
+        const PlannedBook& book = m_order[p];
+        if (!book.deadline || m_minutes[p] <= kMinuteEpsilon) {
+            continue;
+        }
+        const std::int64_t index = findDayAt(end);
+        if (index == kNotScheduled || m_startDay + index > *book.deadline) {
+            missed.push_back(book.bookId);
+        }
+    }
+    return missed;
+}
+
+std::vector<int> GoalPlanner::getOrder() const {
+    std::vector<int> order;
+    order.reserve(m_order.size());
+    for (const PlannedBook& book : m_order) {
+        order.push_back(book.bookId);
+    }
+    return order;
+}
+
+// ==== HELPER METHODS ====
+
+double GoalPlanner::getBookPrefix(std::size_t count) const {
+    double sum = 0.0;
+    for (std::size_t i = count; i > 0; i -= i & (~i + 1)) {
+        sum += m_tree[i];
+    }
+    return sum;
+}
+
+void GoalPlanner::addBookMinutes(std::size_t position, double minutes) {
+    for (std::size_t i = position + 1; i < m_tree.size(); i += i & (~i + 1)) {
+        m_tree[i] += minutes;
+    }
+}
+
+/**
+ * @brief First position whose books reach past a minute mark
+ *
+ * Descends the Fenwick tree: the largest count whose prefix stays at or
+ * below the mark is the position of the book containing it.
+ */
+std::size_t GoalPlanner::findBookAt(double minuteMark) const {
+    std::size_t step = 1;
+    while (step * 2 < m_tree.size()) {
+        step *= 2;
+    }
+    std::size_t count = 0;
+    double sum = 0.0;
+    for (; step > 0; step /= 2) {
+        if (count + step < m_tree.size() && sum + m_tree[count + step] <= minuteMark + kMinuteEpsilon) {
+            count += step;
+            sum += m_tree[count];
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Plan day of a minute mark
+ * @return Index from the start day, or kNotScheduled past the horizon
+ */
+std::int64_t GoalPlanner::findDayAt(double minuteMark) const {
+    if (minuteMark <= kMinuteEpsilon) {
+        return 0; // nothing left: done today
+    }
+    auto it = std::lower_bound(m_capacityPrefix.begin(), m_capacityPrefix.end(), minuteMark - kMinuteEpsilon);
+    if (it == m_capacityPrefix.end()) {
+        return kNotScheduled;
+    }
+    return std::max<std::int64_t>(it - m_capacityPrefix.begin() - 1, 0);
+}
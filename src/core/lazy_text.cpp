@@ -0,0 +1,74 @@
+/**
+ * @file lazy_text.cpp
+ * @brief Implementation of the LazyText class for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "lazy_text.h"
+#include <utility>
+
+// ==== CONSTRUCTORS ====
+
+LazyText::LazyText()
+    : m_text() // Empty text is already "loaded"
+    , m_deferred(nullptr)
+    , m_modified(false)
+{
+}
+
+LazyText::LazyText(std::string text)
+    : m_text(std::move(text))
+    , m_deferred(nullptr)
+    , m_modified(false)
+{
+}
+
+/**
+ * @brief Create a deferred text
+ * @param loader Called once on first access to read the body
+ */
+LazyText LazyText::deferred(std::function<std::string()> loader) {
+    LazyText text;
+    text.m_deferred = std::make_shared<DeferredBody>();
+    text.m_deferred->loader = std::move(loader);
+    return text;
+}
+
+// ==== ACCESS ====
+
+/**
+ * @brief Get the text, loading it if needed
+ *
+ * Concurrent callers wait for a single load; if the loader throws, the
+ * next call tries again.
+ */
+const std::string& LazyText::get() const {
+    if (!m_deferred) {
+        return m_text;
+    }
+    DeferredBody& body = *m_deferred;
+    std::call_once(body.once, [&body]() {
+        body.text = body.loader ? body.loader() : std::string();
+        body.loaded.store(true, std::memory_order_release);
+    });
+    return body.text;
+}
+
+/**
+ * @brief Replace the text
+ */
+void LazyText::set(std::string text) {
+    m_text = std::move(text);
+    m_deferred = nullptr; // The stored body is no longer needed
+    m_modified = true;
+}
+
+bool LazyText::isLoaded() const {
+    return !m_deferred || m_deferred->loaded.load(std::memory_order_acquire);
+}
+
+bool LazyText::isModified() const {
+    return m_modified;
+}
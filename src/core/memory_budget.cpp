@@ -0,0 +1,297 @@
+/**
+ * @file memory_budget.cpp
+ * @brief Implementation of the memory accounting for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "memory_budget.h"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/// Set while this thread runs reclaimers, so nested enforcement is skipped
+thread_local bool t_enforcing = false;
+
+/**
+ * @brief Format a byte count for reports ("12.5 MiB")
+ */
+std::string formatBytes(std::int64_t bytes) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.1f MiB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    return buffer;
+}
+
+/**
+ * @brief Parse a size such as "512M"
+ * @throws std::invalid_argument if the size is malformed or does not fit 64 bits
+ */
+std::int64_t parseSize(const std::string& text) {
+    std::string digits = text;
+    std::int64_t unit = 1;
+    if (!digits.empty()) {
+        switch (digits.back()) {
+            case 'K': case 'k': unit = 1024; break;
+            case 'M': case 'm': unit = 1024 * 1024; break;
+            case 'G': case 'g': unit = 1024 * 1024 * 1024; break;
+            default: break;
+        }
+        if (unit != 1) {
+            digits.pop_back();
+        }
+    }
+
+    std::size_t end = 0;
+    long long value = -1;
+    try {
+        value = std::stoll(digits, &end);
+    } catch (const std::exception&) {
+        end = 0;
+    }
+    if (digits.empty() || end != digits.size() || value < 0 ||
+        value > std::numeric_limits<std::int64_t>::max() / unit) {
+        throw std::invalid_argument("Invalid memory size '" + text + "'");
+    }
+    return static_cast<std::int64_t>(value) * unit;
+}
+
+} // namespace
+
+/**
+ * @brief Short name of a subsystem
+ */
+const char* getSubsystemName(MemorySubsystem subsystem) {
+    switch (subsystem) {
+        case MemorySubsystem::BookTable:   return "book_table";
+        case MemorySubsystem::SortKeys:    return "sort_keys";
+        case MemorySubsystem::EditHistory: return "edit_history";
+        case MemorySubsystem::Count:       break;
+    }
+    return "unknown";
+}
+
+// ==== MEMORY ACCOUNTING ====
+
+MemoryAccounting& MemoryAccounting::global() {
+    static MemoryAccounting accounting;
+    return accounting;
+}
+
+MemoryAccounting::MemoryAccounting()
+    : m_pending(false)
+    , m_nextHandle(1)
+{
+    for (std::size_t i = 0; i < kMemorySubsystemCount; ++i) {
+        m_bytes[i] = 0;
+        m_peaks[i] = 0;
+        m_budgets[i] = 0;
+    }
+}
+
+/**
+ * @brief Add or remove bytes from a subsystem
+ *
+ * Flags the subsystem for enforceBudgets() when it crosses its budget.
+ */
+void MemoryAccounting::charge(MemorySubsystem subsystem, std::int64_t bytes) {
+    const std::size_t index = static_cast<std::size_t>(subsystem);
+    const std::int64_t total = m_bytes[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    std::int64_t peak = m_peaks[index].load(std::memory_order_relaxed);
+    while (total > peak &&
+           !m_peaks[index].compare_exchange_weak(peak, total, std::memory_order_relaxed)) {
+    }
+
+    const std::int64_t budget = m_budgets[index].load(std::memory_order_relaxed);
+    if (bytes > 0 && budget > 0 && total > budget) {
+        m_pending.store(true, std::memory_order_release);
+    }
+}
+
+std::int64_t MemoryAccounting::getBytes(MemorySubsystem subsystem) const {
+    return m_bytes[static_cast<std::size_t>(subsystem)].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Figures of every subsystem
+ */
+std::vector<MemoryUsage> MemoryAccounting::getUsage() const {
+    std::vector<MemoryUsage> usage;
+    for (std::size_t i = 0; i < kMemorySubsystemCount; ++i) {
+        usage.push_back(MemoryUsage{ static_cast<MemorySubsystem>(i),
+                                     m_bytes[i].load(std::memory_order_relaxed),
+                                     m_peaks[i].load(std::memory_order_relaxed),
+                                     m_budgets[i].load(std::memory_order_relaxed) });
+    }
+    return usage;
+}
+
+/**
+ * @brief Format the figures as a text table
+ */
+std::string MemoryAccounting::formatReport() const {
+    std::ostringstream report;
+    char line[128];
+    std::snprintf(line, sizeof(line), "%-14s %14s %14s %14s\n", "subsystem", "current", "peak", "budget");
+    report << line;
+
+    std::int64_t total = 0;
+    for (const MemoryUsage& usage : getUsage()) {
+        total += usage.bytes;
+        std::snprintf(line, sizeof(line), "%-14s %14s %14s %14s%s\n",
+                      getSubsystemName(usage.subsystem), formatBytes(usage.bytes).c_str(),
+                      formatBytes(usage.peak).c_str(),
+                      usage.budget > 0 ? formatBytes(usage.budget).c_str() : "none",
+                      usage.budget > 0 && usage.bytes > usage.budget ? "  OVER" : "");
+        report << line;
+    }
+    std::snprintf(line, sizeof(line), "%-14s %14s\n", "total", formatBytes(total).c_str());
+    report << line;
+    return report.str();
+}
+
+// ==== BUDGETS ====
+
+void MemoryAccounting::setBudget(MemorySubsystem subsystem, std::int64_t bytes) {
+    const std::size_t index = static_cast<std::size_t>(subsystem);
+    m_budgets[index].store(std::max<std::int64_t>(bytes, 0), std::memory_order_relaxed);
+    if (isOverBudget(subsystem)) {
+        m_pending.store(true, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Set budgets from a "name=size,..." spec
+ */
+void MemoryAccounting::setBudgets(const std::string& spec) {
+    std::istringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        if (entry.empty()) {
+            continue;
+        }
+        const std::size_t equals = entry.find('=');
+        if (equals == std::string::npos) {
+            throw std::invalid_argument("Expected name=size in '" + entry + "'");
+        }
+        const std::string name = entry.substr(0, equals);
+        std::size_t index = 0;
+        while (index < kMemorySubsystemCount &&
+               name != getSubsystemName(static_cast<MemorySubsystem>(index))) {
+            ++index;
+        }
+        if (index == kMemorySubsystemCount) {
+            throw std::invalid_argument("Unknown memory subsystem '" + name + "'");
+        }
+        setBudget(static_cast<MemorySubsystem>(index), parseSize(entry.substr(equals + 1)));
+    }
+}
+
+std::int64_t MemoryAccounting::getBudget(MemorySubsystem subsystem) const {
+    return m_budgets[static_cast<std::size_t>(subsystem)].load(std::memory_order_relaxed);
+}
+
+bool MemoryAccounting::isOverBudget(MemorySubsystem subsystem) const {
+    const std::int64_t budget = getBudget(subsystem);
+    return budget > 0 && getBytes(subsystem) > budget;
+}
+
+int MemoryAccounting::addReclaimer(MemorySubsystem subsystem, Reclaimer reclaimer) {
+    std::lock_guard<std::mutex> lock(m_reclaimMutex);
+    const int handle = m_nextHandle++;
+    m_reclaimers.push_back(Registration{ handle, subsystem, std::move(reclaimer) });
+    return handle;
+}
+
+void MemoryAccounting::removeReclaimer(int handle) {
+    std::lock_guard<std::mutex> lock(m_reclaimMutex);
+    m_reclaimers.erase(std::remove_if(m_reclaimers.begin(), m_reclaimers.end(),
+                                      [&](const Registration& r) { return r.handle == handle; }),
+                       m_reclaimers.end());
+}
+
+/**
+ * @brief Run the reclaimers of subsystems that went over budget
+ *
+ * Reclaimers of one subsystem run in registration order until it is
+ * back under budget.
+ */
+void MemoryAccounting::enforceBudgets() {
+    if (t_enforcing || !m_pending.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_reclaimMutex);
+    t_enforcing = true;
+    try {
+        for (const Registration& registration : m_reclaimers) {
+            if (isOverBudget(registration.subsystem)) {
+                registration.reclaimer(getBytes(registration.subsystem) -
+                                       getBudget(registration.subsystem));
+            }
+        }
+    } catch (...) {
+        t_enforcing = false;
+        throw;
+    }
+    t_enforcing = false;
+}
+
+// ==== MEMORY CHARGE ====
+
+MemoryCharge::MemoryCharge(MemorySubsystem subsystem, std::int64_t bytes)
+    : m_subsystem(subsystem)
+    , m_bytes(bytes)
+{
+    MemoryAccounting::global().charge(m_subsystem, m_bytes);
+}
+
+MemoryCharge::MemoryCharge(const MemoryCharge& other)
+    : MemoryCharge(other.m_subsystem, other.m_bytes)
+{
+}
+
+MemoryCharge::MemoryCharge(MemoryCharge&& other) noexcept
+    : m_subsystem(other.m_subsystem)
+    , m_bytes(other.m_bytes)
+{
+    other.m_bytes = 0;
+}
+
+MemoryCharge& MemoryCharge::operator=(const MemoryCharge& other) {
+    if (this != &other) {
+        MemoryAccounting::global().charge(m_subsystem, -m_bytes);
+        m_subsystem = other.m_subsystem;
+        m_bytes = other.m_bytes;
+        MemoryAccounting::global().charge(m_subsystem, m_bytes);
+    }
+    return *this;
+}
+
+MemoryCharge& MemoryCharge::operator=(MemoryCharge&& other) noexcept {
+    if (this != &other) {
+        MemoryAccounting::global().charge(m_subsystem, -m_bytes);
+        m_subsystem = other.m_subsystem;
+        m_bytes = other.m_bytes;
+        other.m_bytes = 0;
+    }
+    return *this;
+}
+
+MemoryCharge::~MemoryCharge() {
+    MemoryAccounting::global().charge(m_subsystem, -m_bytes);
+}
+
+void MemoryCharge::set(std::int64_t bytes) {
+    MemoryAccounting::global().charge(m_subsystem, bytes - m_bytes);
+    m_bytes = bytes;
+}
+
+std::int64_t MemoryCharge::get() const {
+    return m_bytes;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file parallel.cpp
+ * @brief Implementation of the fork-join helper for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Number of workers parallelFor() will use for a task count
+ */
+std::size_t getWorkerCount(std::size_t taskCount) {
+    if (taskCount < kMinParallelTasks) {
+        return 1;
+    }
+    std::size_t hardware = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    return std::min(hardware, taskCount);
+}
+
+/**
+ * @brief Run body(worker, task) for every task in [0, taskCount)
+ *
+ * The calling thread works as worker 0, so a single worker never
+ * starts a thread. If a thread cannot be started, the ones already
+ * running and the calling thread share the remaining tasks.
+ */
+void parallelFor(std::size_t taskCount,
+                 const std::function<void(std::size_t worker, std::size_t task)>& body) {
+    const std::size_t workers = getWorkerCount(taskCount);
+    std::atomic<std::size_t> nextTask{ 0 };
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+
+    auto work = [&](std::size_t worker) {
+        try {
+            for (std::size_t task = nextTask++; task < taskCount; task = nextTask++) {
+                body(worker, task);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            nextTask = taskCount; // Stop handing out work
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    try {
+        for (std::size_t worker = 1; worker < workers; ++worker) {
+            threads.emplace_back(work, worker);
+        }
+    } catch (...) {
+        // No thread or no memory for it: tasks are handed out
+        // dynamically, so fewer workers still finish them all
+    }
+    work(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file reading_event.cpp
+ * @brief Parsing of reading tracker log lines for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "reading_event.h"
+#include <sstream>
+
+/**
+ * @brief Parse one line of an activity log
+ * @param line A line without its trailing newline
+ * @return The event, or empty if the line holds none
+ */
+std::optional<ReadingEvent> parseReadingEvent(const std::string& line) {
+    std::istringstream stream(line);
+
+    long long seconds = 0;
+    ReadingEvent event;
+    if (!(stream >> seconds >> event.bookId >> event.page)) {
+        return std::nullopt; // Blank, comment ('#' fails the number read) or malformed
+    }
+
+    // Anything after the page is a malformed line, not an extra field
+    std::string rest;
+    if (stream >> rest) {
+        return std::nullopt;
+    }
+
+    if (seconds < 0 || event.bookId <= 0 || event.page < 0) {
+        return std::nullopt;
+    }
+
+    event.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+    return event;
+}
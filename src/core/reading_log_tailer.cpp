@@ -0,0 +1,304 @@
+/**
+ * @file reading_log_tailer.cpp
+ * @brief Implementation of the ReadingLogTailer class for the Personal Reading Management System (PRMS)
+ *
+ * Uses POSIX file APIs to follow the log and, on Linux, inotify to wake
+ * up as soon as it changes.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "reading_log_tailer.h"
+#include "database.h"
+
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+namespace {
+
+/// How long the thread sleeps between checks when no change is signalled
+constexpr int kPollIntervalMs = 500;
+
+/// How many bytes are read (and applied as one batch) at a time
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+
+} // namespace
+
+// ==== CONSTRUCTOR and DESTRUCTOR ====
+
+/**
+ * @brief Constructor - prepares a tailer, does not start it
+ * @param dbPath Path of the database to apply events to
+ * @param logPath Path of the activity log to follow
+ */
+ReadingLogTailer::ReadingLogTailer(const std::string& dbPath, const std::string& logPath)
+    : m_dbPath(dbPath)
+    , m_logPath(logPath)
+    , m_database(nullptr)
+    , m_listener(nullptr)
+    , m_fd(-1)
+    , m_inode(0)
+    , m_readOffset(0)
+    , m_pending("")
+    , m_skippedLines(0)
+    , m_running(false)
+{
+}
+
+/**
+ * @brief Destructor - stops the tailer thread
+ */
+ReadingLogTailer::~ReadingLogTailer() {
+    stop();
+    closeLog();
+}
+
+// ==== CONTROL ====
+
+void ReadingLogTailer::setListener(Listener listener) {
+    m_listener = std::move(listener);
+}
+
+/**
+ * @brief Start following the log on a background thread
+ */
+void ReadingLogTailer::start() {
+    if (m_running) {
+        return;
+    }
+
+    // Open on the caller's thread so a bad path is reported right away
+    openDatabase();
+
+    m_running = true;
+    m_thread = std::thread(&ReadingLogTailer::run, this);
+}
+
+/**
+ * @brief Stop following the log and wait for the thread to exit
+ */
+void ReadingLogTailer::stop() {
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool ReadingLogTailer::isRunning() const {
+    return m_running;
+}
+
+std::uint64_t ReadingLogTailer::getSkippedLineCount() const {
+    return m_skippedLines;
+}
+
+/**
+ * @brief Read and apply everything written since the last call
+ * @return Number of events applied
+ */
+int ReadingLogTailer::processNewLines() {
+    if (!m_database) {
+        openDatabase();
+    }
+    if (m_fd < 0 && !openLog()) {
+        return 0; // The log doesn't exist (yet)
+    }
+
+    // Always finish the file we have open: after a rotation it still
+    // holds the last lines written before the rename
+    int applied = drainLog();
+
+    struct stat current;
+    if (::stat(m_logPath.c_str(), &current) != 0) {
+        return applied; // Rotated away and not recreated yet
+    }
+
+    if (static_cast<std::uint64_t>(current.st_ino) != m_inode) {
+        // The path now names a new file: switch to it
+        closeLog();
+        if (openLog()) {
+            applied += drainLog();
+        }
+    } else if (current.st_size < m_readOffset) {
+        // Truncated in place: everything is new again
+        m_readOffset = 0;
+        m_pending.clear();
+        applied += drainLog();
+    }
+    return applied;
+}
+
+// ==== HELPER METHODS ====
+
+/**
+ * @brief Open the database connection used by the tailer
+ */
+void ReadingLogTailer::openDatabase() {
+    m_database = std::make_unique<Database>(m_dbPath);
+    if (!m_database->initialize()) {
+        throw std::runtime_error("Cannot initialize database: " + m_database->getLastError());
+    }
+}
+
+/**
+ * @brief Open the log file, resuming from the checkpoint if valid
+ * @return True if the file is open
+ */
+bool ReadingLogTailer::openLog() {
+    m_fd = ::open(m_logPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0) {
+        closeLog();
+        return false;
+    }
+    m_inode = static_cast<std::uint64_t>(info.st_ino);
+    m_readOffset = 0;
+    m_pending.clear();
+
+    // Resume only if the checkpoint belongs to this very file
+    std::optional<LogCheckpoint> checkpoint = m_database->loadLogCheckpoint(m_logPath);
+    if (checkpoint && checkpoint->inode == m_inode && checkpoint->offset <= info.st_size) {
+        m_readOffset = checkpoint->offset;
+    }
+    return true;
+}
+
+/**
+ * @brief Read the open log to its end and apply complete lines
+ * @return Number of events applied
+ *
+ * Each chunk read is applied in its own transaction together with the
+ * offset of the last complete line, so a crash at any point resumes at
+ * a line boundary without losing or repeating events.
+ */
+int ReadingLogTailer::drainLog() {
+    int applied = 0;
+    std::string buffer(kReadChunkSize, '\0');
+
+    while (true) {
+        ssize_t count = ::pread(m_fd, &buffer[0], buffer.size(), m_readOffset);
+        if (count <= 0) {
+            break; // End of file (or an error we retry on the next wake-up)
+        }
+        m_readOffset += count;
+        m_pending.append(buffer.data(), static_cast<std::size_t>(count));
+
+        std::size_t end = m_pending.rfind('\n');
+        if (end == std::string::npos) {
+            continue; // No complete line yet
+        }
+
+        std::vector<ReadingEvent> events;
+        std::size_t start = 0;
+        while (start <= end) {
+            std::size_t newline = m_pending.find('\n', start);
+            std::string line = m_pending.substr(start, newline - start);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+
+            std::optional<ReadingEvent> event = parseReadingEvent(line);
+            if (event) {
+                events.push_back(*event);
+            } else if (line.find_first_not_of(" \t") != std::string::npos && line[0] != '#') {
+                ++m_skippedLines; // Not blank, not a comment: malformed
+            }
+            start = newline + 1;
+        }
+        m_pending.erase(0, end + 1);
+
+        LogCheckpoint checkpoint;
+        checkpoint.path = m_logPath;
+        checkpoint.inode = m_inode;
+        checkpoint.offset = m_readOffset - static_cast<std::int64_t>(m_pending.size());
+
+        bool ok = m_database->beginTransaction()
+               && m_database->applyReadingEvents(events)
+               && m_database->saveLogCheckpoint(checkpoint);
+        if (!ok || !m_database->commitTransaction()) {
+            // Rewind to the last good line and try again on the next wake-up
+            m_database->rollbackTransaction();
+            m_readOffset = checkpoint.offset - static_cast<std::int64_t>(end + 1);
+            m_pending.clear();
+            break;
+        }
+
+        applied += static_cast<int>(events.size());
+        if (m_listener && !events.empty()) {
+            m_listener(events);
+        }
+    }
+    return applied;
+}
+
+/**
+ * @brief Close the log file
+ */
+void ReadingLogTailer::closeLog() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+/**
+ * @brief Body of the background thread
+ *
+ * Waits for a change to the log's directory (which also catches the log
+ * being renamed or recreated) and then processes new lines. The timeout
+ * keeps stop() responsive and covers changes inotify cannot see, such
+ * as writes over network filesystems.
+ */
+void ReadingLogTailer::run() {
+#ifdef __linux__
+    std::filesystem::path directory = std::filesystem::path(m_logPath).parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    int notifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFd >= 0) {
+        ::inotify_add_watch(notifyFd, directory.c_str(),
+                            IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE);
+    }
+
+    processNewLines();
+    while (m_running) {
+        if (notifyFd >= 0) {
+            struct pollfd waiter = { notifyFd, POLLIN, 0 };
+            if (::poll(&waiter, 1, kPollIntervalMs) > 0) {
+                // We only care that something changed, not what
+                char events[4096];
+                while (::read(notifyFd, events, sizeof(events)) > 0) {
+                }
+            }
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+        }
+        processNewLines();
+    }
+
+    if (notifyFd >= 0) {
+        ::close(notifyFd);
+    }
+#else
+    processNewLines();
+    while (m_running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+        processNewLines();
+    }
+#endif
+}
@@ -0,0 +1,191 @@
+/**
+ * @file recommender.cpp
+ * @brief Implementation of the Recommender class for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "recommender.h"
+#include "factor_support.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Items measured per parallel task
+constexpr std::size_t kBlockSize = 16384;
+
+float dot(const float* a, const float* b, std::uint32_t rank) {
+    float sum = 0.0f;
+    for (std::uint32_t d = 0; d < rank; ++d) {
+        sum += a[d] * b[d];
+    }
+    return sum;
+}
+
+} // namespace
+
+// ==== CONSTRUCTOR ====
+
+/**
+ * @brief Constructor
+ *
+ * Measures the largest vector norm of the catalog once (it bounds how
+ * far an item's score can move with the profile).
+ */
+Recommender::Recommender(const FactorFile& factors, std::size_t poolSize)
+    : m_factors(factors)
+    , m_poolSize(std::max<std::size_t>(poolSize, 1))
+    , m_maxNorm(0.0f)
+    , m_profileSum(factors.getRank(), 0.0)
+    , m_profile(factors.getRank(), 0.0f)
+    , m_rebuildProfile(factors.getRank(), 0.0f)
+    , m_threshold(0.0f)
+    , m_poolComplete(false)
+{
+    const std::size_t count = factors.getItemCount();
+    const std::uint32_t rank = factors.getRank();
+    const std::size_t blocks = (count + kBlockSize - 1) / kBlockSize;
+    std::vector<float> norms(getWorkerCount(blocks), 0.0f);
+    parallelFor(blocks, [&](std::size_t worker, std::size_t block) {
+        const std::size_t end = std::min(count, (block + 1) * kBlockSize);
+        for (std::size_t item = block * kBlockSize; item < end; ++item) {
+            const float* vector = factors.getVector(item);
+            norms[worker] = std::max(norms[worker], dot(vector, vector, rank));
+        }
+    });
+    for (float norm : norms) {
+        m_maxNorm = std::max(m_maxNorm, std::sqrt(norm));
+    }
+}
+
+// ==== UPDATES ====
+
+/**
+ * @brief Recompute everything from the user's books (scans the catalog)
+ */
+void Recommender::rebuild(const std::vector<Book>& history) {
+    const std::vector<std::uint32_t> items = findCompletedItems(m_factors, history);
+    m_completed.clear();
+    m_completed.insert(items.begin(), items.end());
+    std::fill(m_profileSum.begin(), m_profileSum.end(), 0.0);
+    for (std::uint32_t item : items) {
+        const float* vector = m_factors.getVector(item);
+        for (std::size_t d = 0; d < m_profileSum.size(); ++d) {
+            m_profileSum[d] += vector[d];
+        }
+    }
+    updateProfile();
+    m_rebuildProfile = m_profile;
+
+    if (items.empty()) {
+        m_pool.clear(); // nothing to recommend from; the first completion triggers a rebuild
+        m_poolComplete = false;
+        m_threshold = 0.0f;
+        return;
+    }
+    m_pool = scoreItems(m_factors, m_profile, m_poolSize, items);
+    m_poolComplete = m_pool.size() < m_poolSize;
+    m_threshold = m_pool.empty() ? 0.0f : m_pool.back().score;
+}
+
+/**
+ * @brief Account for a newly completed book (no catalog scan)
+ */
+bool Recommender::addCompleted(const Book& book) {
+    if (!book.isCompleted()) {
+        return false;
+    }
+    const std::string key = normalizeIsbn(book.getISBN());
+    const std::int64_t found = key.empty() ? -1 : m_factors.findItem(key);
+    if (found < 0 || !m_completed.insert(static_cast<std::uint32_t>(found)).second) {
+        return false;
+    }
+    const auto item = static_cast<std::uint32_t>(found);
+    const float* vector = m_factors.getVector(item);
+    for (std::size_t d = 0; d < m_profileSum.size(); ++d) {
+        m_profileSum[d] += vector[d];
+    }
+    updateProfile();
+
+    m_pool.erase(std::remove_if(m_pool.begin(), m_pool.end(),
+                                [item](const ItemScore& score) { return score.item == item; }),
+                 m_pool.end());
+    rescorePool();
+    return true;
+}
+
+// ==== RESULTS ====
+
+std::vector<ItemScore> Recommender::getRecommendations(std::size_t k) const {
+    if (m_completed.empty()) {
+        return {};
+    }
+    return std::vector<ItemScore>(m_pool.begin(), m_pool.begin() + std::min(k, m_pool.size()));
+}
+
+/**
+ * @brief "Because you finished X" suggestions
+ *
+ * Restricting them to the pool keeps them in line with the overall
+ * taste and costs one dot product per pool item.
+ */
+std::vector<ItemScore> Recommender::getBecauseYouFinished(const Book& book, std::size_t k) const {
+    const std::string key = normalizeIsbn(book.getISBN());
+    const std::int64_t found = key.empty() ? -1 : m_factors.findItem(key);
+    if (found < 0) {
+        return {};
+    }
+    const float* finished = m_factors.getVector(static_cast<std::size_t>(found));
+    std::vector<ItemScore> affinities;
+    affinities.reserve(m_pool.size());
+    for (const ItemScore& candidate : m_pool) {
+        affinities.push_back(ItemScore{ candidate.item,
+                                        dot(finished, m_factors.getVector(candidate.item), m_factors.getRank()) });
+    }
+    const std::size_t count = std::min(k, affinities.size());
+    std::partial_sort(affinities.begin(), affinities.begin() + count, affinities.end(), isBetter);
+    affinities.resize(count);
+    return affinities;
+}
+
+/**
+ * @brief Whether the pool can no longer vouch for the top k
+ */
+bool Recommender::needsRebuild(std::size_t k) const {
+    if (m_completed.empty() || m_poolComplete) {
+        return false;
+    }
+    if (m_pool.size() < k || m_pool.empty()) {
+        return true;
+    }
+    double drift = 0.0;
+    for (std::size_t d = 0; d < m_profile.size(); ++d) {
+        const double delta = m_profile[d] - m_rebuildProfile[d];
+        drift += delta * delta;
+    }
+    const double bound = m_threshold + std::sqrt(drift) * m_maxNorm;
+    return m_pool[std::max<std::size_t>(k, 1) - 1].score < bound;
+}
+
+std::size_t Recommender::getCompletedCount() const {
+    return m_completed.size();
+}
+
+// ==== HELPER METHODS ====
+
+void Recommender::updateProfile() {
+    const double count = static_cast<double>(std::max<std::size_t>(m_completed.size(), 1));
+    for (std::size_t d = 0; d < m_profile.size(); ++d) {
+        m_profile[d] = static_cast<float>(m_profileSum[d] / count);
+    }
+}
+
+void Recommender::rescorePool() {
+    for (ItemScore& candidate : m_pool) {
+        candidate.score = dot(m_factors.getVector(candidate.item), m_profile.data(), m_factors.getRank());
+    }
+    std::sort(m_pool.begin(), m_pool.end(), isBetter);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file sort_key.cpp
+ * @brief Implementation of the collated sort keys for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "sort_key.h"
+#include "book_sort.h"
+#include <stdexcept>
+
+// ==== SORT KEY GENERATOR ====
+
+/**
+ * @brief Constructor - loads the collation rules of a locale
+ * @param localeName Locale name ("" for the environment's locale)
+ */
+SortKeyGenerator::SortKeyGenerator(const std::string& localeName)
+    : m_localeName(localeName)
+{
+    try {
+        m_locale = std::locale(localeName.c_str());
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Locale '" + localeName + "' is not available");
+    }
+    if (m_localeName.empty()) {
+        m_localeName = m_locale.name(); // Tag keys with the resolved name
+    }
+}
+
+const std::string& SortKeyGenerator::getLocaleName() const {
+    return m_localeName;
+}
+
+/**
+ * @brief Build the sort key of a string
+ *
+ * This is strxfrm() behind the std::collate facet: the expensive
+ * collation work happens once here instead of in every comparison.
+ */
+std::string SortKeyGenerator::makeKey(const std::string& text) const {
+    const std::collate<char>& collate = std::use_facet<std::collate<char>>(m_locale);
+    return collate.transform(text.data(), text.data() + text.size());
+}
+
+// ==== SNAPSHOT ORDERING ====
+
+/**
+ * @brief Sort the books of a snapshot by their collated sort keys
+ *
+ * The sort keys (plus the ID as a tie breaker) are packed into one
+ * normalized key per row and handed to the radix sorter, so sorting is
+ * memcmp work only.
+ */
+std::vector<SnapshotRow> collatedOrder(const BookTableSnapshot& snapshot, CollatedOrder order) {
+    std::vector<SnapshotRow> rows;
+    rows.reserve(snapshot.size());
+
+    std::string keys;
+    std::vector<std::uint32_t> offsets;
+    offsets.reserve(snapshot.size() + 1);
+
+    for (std::size_t c = 0; c < snapshot.getChunkCount(); ++c) {
+        const BookChunk& chunk = snapshot.getChunk(c);
+        const bool keyed = chunk.sortKeys != nullptr;
+        const std::vector<std::string>& titles = keyed ? chunk.titleKeys : chunk.titles;
+        const std::vector<std::string>& authors = keyed ? chunk.authorKeys : chunk.authors;
+
+        for (std::size_t row = 0; row < chunk.size(); ++row) {
+            offsets.push_back(static_cast<std::uint32_t>(keys.size()));
+            if (order == CollatedOrder::Title) {
+                encodeStringKey(titles[row], keys);
+                encodeStringKey(authors[row], keys);
+            } else {
+                encodeStringKey(authors[row], keys);
+                encodeStringKey(titles[row], keys);
+            }
+            encodeUnsignedKey(integerKey(chunk.ids[row]), keys);
+            rows.push_back(SnapshotRow{ static_cast<std::uint32_t>(c),
+                                        static_cast<std::uint32_t>(row) });
+        }
+    }
+    offsets.push_back(static_cast<std::uint32_t>(keys.size()));
+
+    std::vector<SnapshotRow> sorted;
+    sorted.reserve(rows.size());
+    for (std::uint32_t position : sortNormalizedKeys(keys, offsets)) {
+        sorted.push_back(rows[position]);
+    }
+    return sorted;
+}
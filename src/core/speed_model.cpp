@@ -0,0 +1,220 @@
+/**
+ * @file speed_model.cpp
+ * @brief Implementation of the calibrated reading speed model for the Personal Reading Management System (PRMS)
+ *
+ * The gather kernel is compiled for AVX2 with a target attribute and
+ * picked at run time, so the build needs no special flags and older
+ * CPUs fall back to the scalar loop.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "speed_model.h"
+#include "factor_support.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// How far one test moves the prediction towards its result (in log space)
+constexpr double kLearningRate = 0.5;
+
+/// How a test's error is shared between the factors (sums to 1)
+constexpr double kBaseShare = 0.4;
+constexpr double kGenreShare = 0.3;
+constexpr double kDifficultyShare = 0.15;
+constexpr double kTimeOfDayShare = 0.15;
+
+/// Speed factors of the difficulty buckets before any test
+constexpr double kDifficultyPriors[kDifficultyBuckets] = { 1.15, 1.05, 1.0, 0.9, 0.8 };
+
+constexpr std::int64_t kSecondsPerDay = 24 * 60 * 60;
+
+int clampDifficulty(int difficulty) {
+    return std::clamp(difficulty, 0, static_cast<int>(kDifficultyBuckets) - 1);
+}
+
+// ==== ESTIMATION KERNELS ====
+
+/**
+ * @brief minutes[i] = words[i] / table[cells[i] + timeOfDay]
+ */
+void estimateScalar(const float* table, const std::int32_t* cells, const float* words,
+                    std::int32_t timeOfDay, float* minutes, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        minutes[i] = words[i] / table[cells[i] + timeOfDay];
+    }
+}
+
+#ifdef PRMS_HAVE_AVX2_GATHER
+/**
+ * @brief The same, eight books at a time with a gather
+ */
+__attribute__((target("avx2")))
+void estimateAvx2(const float* table, const std::int32_t* cells, const float* words,
+                  std::int32_t timeOfDay, float* minutes, std::size_t count) {
+    const __m256i offset = _mm256_set1_epi32(timeOfDay);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i index = _mm256_add_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + i)), offset);
+        const __m256 wpm = _mm256_i32gather_ps(table, index, 4);
+        _mm256_storeu_ps(minutes + i, _mm256_div_ps(_mm256_loadu_ps(words + i), wpm));
+    }
+    estimateScalar(table, cells, words, timeOfDay, minutes, i, count);
+}
+#endif
+
+} // namespace
+
+// ==== CONSTRUCTOR ====
+
+SpeedModel::SpeedModel(double baseWpm, std::int64_t utcOffsetSeconds)
+    : m_logBase(std::log(std::max(baseWpm, 1.0)))
+    , m_logDifficulty{}
+    , m_logTimeOfDay{}
+    , m_utcOffsetSeconds(utcOffsetSeconds)
+    , m_tests(0)
+{
+    for (std::size_t d = 0; d < kDifficultyBuckets; ++d) {
+        m_logDifficulty[d] = std::log(kDifficultyPriors[d]);
+    }
+    addGenre(""); // row 0: books without a genre
+}
+
+// ==== CALIBRATION ====
+
+/**
+ * @brief Fold a speed test into the model and rebuild the table
+ *
+ * One gradient step in log space: the error between the measured and
+ * the predicted speed is shared between the factors involved.
+ */
+void SpeedModel::recordSpeedTest(const SpeedTest& test) {
+    if (test.words <= 0 || test.minutes <= 0.0) {
+        return;
+    }
+    const int row = addGenre(test.genre);
+    const int difficulty = clampDifficulty(test.difficulty);
+    const int timeOfDay = getTimeOfDayBucket(test.time);
+
+    const double predicted = m_logBase + m_logGenre[row] + m_logDifficulty[difficulty] + m_logTimeOfDay[timeOfDay];
+    const double error = std::log(static_cast<double>(test.words) / test.minutes) - predicted;
+    m_logBase += kLearningRate * kBaseShare * error;
+    m_logGenre[row] += kLearningRate * kGenreShare * error;
+    m_logDifficulty[difficulty] += kLearningRate * kDifficultyShare * error;
+    m_logTimeOfDay[timeOfDay] += kLearningRate * kTimeOfDayShare * error;
+
+    ++m_tests;
+    rebuildTable();
+}
+
+std::size_t SpeedModel::getTestCount() const {
+    return m_tests;
+}
+
+// ==== LOOKUP ====
+
+int SpeedModel::addGenre(const std::string& genre) {
+    auto [it, added] = m_genreRows.try_emplace(genre, static_cast<int>(m_logGenre.size()));
+    if (added) {
+        m_logGenre.push_back(0.0);
+        rebuildTable();
+    }
+    return it->second;
+}
+
+int SpeedModel::getTimeOfDayBucket(std::chrono::system_clock::time_point time) const {
+    const std::int64_t seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count() + m_utcOffsetSeconds;
+    const std::int64_t secondOfDay = ((seconds % kSecondsPerDay) + kSecondsPerDay) % kSecondsPerDay;
+    return static_cast<int>(secondOfDay * static_cast<std::int64_t>(kTimeOfDayBuckets) / kSecondsPerDay);
+}
+
+std::int32_t SpeedModel::getCell(int genreRow, int difficulty) {
+    return (genreRow * static_cast<std::int32_t>(kDifficultyBuckets) + clampDifficulty(difficulty)) *
+           static_cast<std::int32_t>(kTimeOfDayBuckets);
+}
+
+float SpeedModel::getWpm(const std::string& genre, int difficulty, int timeOfDay) const {
+    auto it = m_genreRows.find(genre);
+    const int row = it == m_genreRows.end() ? 0 : it->second;
+    const int time = std::clamp(timeOfDay, 0, static_cast<int>(kTimeOfDayBuckets) - 1);
+    return m_table[getCell(row, difficulty) + time];
+}
+
+const std::vector<float>& SpeedModel::getTable() const {
+    return m_table;
+}
+
+/**
+ * @brief Recompute every cell from the factors
+ *
+ * A few thousand cells at most, so rebuilding is cheaper than tracking
+ * which cells a test touched (the base factor touches all of them).
+ */
+void SpeedModel::rebuildTable() {
+    m_table.resize(m_logGenre.size() * kDifficultyBuckets * kTimeOfDayBuckets);
+    std::size_t cell = 0;
+    for (double genre : m_logGenre) {
+        for (double difficulty : m_logDifficulty) {
+            for (double timeOfDay : m_logTimeOfDay) {
+                m_table[cell++] = static_cast<float>(std::exp(m_logBase + genre + difficulty + timeOfDay));
+            }
+        }
+    }
+}
+
+// ==== ESTIMATION ====
+
+/**
+ * @brief Collect the books still to read from a snapshot
+ */
+SpeedCandidates collectSpeedCandidates(const BookTableSnapshot& snapshot, SpeedModel& model,
+                                       const std::function<int(int bookId)>& difficultyOf,
+                                       double wordsPerPage) {
+    SpeedCandidates candidates;
+    for (std::size_t c = 0; c < snapshot.getChunkCount(); ++c) {
+        const BookChunk& chunk = snapshot.getChunk(c);
+
+        // Resolve each distinct genre of the chunk once
+        std::vector<int> rows;
+        for (const std::string& genre : chunk.genres.getDictionary()) {
+            rows.push_back(model.addGenre(genre));
+        }
+
+        for (std::size_t row = 0; row < chunk.size(); ++row) {
+            if (isInState(ReadingState::Completed, chunk.pageCounts[row], chunk.currentPages[row],
+                          chunk.completionDates[row])) {
+                continue;
+            }
+            const int id = chunk.ids[row];
+            const int pagesLeft = std::max(chunk.pageCounts[row] - chunk.currentPages[row], 0);
+            const int difficulty = difficultyOf ? difficultyOf(id) : kDefaultDifficulty;
+            candidates.bookIds.push_back(id);
+            candidates.cells.push_back(SpeedModel::getCell(rows[chunk.genres.codeAt(row)], difficulty));
+            candidates.words.push_back(static_cast<float>(pagesLeft * wordsPerPage));
+        }
+    }
+    return candidates;
+}
+
+/**
+ * @brief Estimate the reading time of every candidate
+ */
+void estimateReadingMinutes(const SpeedModel& model, const SpeedCandidates& candidates,
+                            int timeOfDay, std::vector<float>& minutes) {
+    const std::size_t count = candidates.cells.size();
+    const std::int32_t time = std::clamp(timeOfDay, 0, static_cast<int>(kTimeOfDayBuckets) - 1);
+    minutes.resize(count);
+#ifdef PRMS_HAVE_AVX2_GATHER
+    if (hasAvx2()) {
+        estimateAvx2(model.getTable().data(), candidates.cells.data(), candidates.words.data(),
+                     time, minutes.data(), count);
+        return;
+    }
+#endif
+    estimateScalar(model.getTable().data(), candidates.cells.data(), candidates.words.data(),
+                   time, minutes.data(), 0, count);
+}
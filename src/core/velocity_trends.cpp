@@ -0,0 +1,347 @@
+/**
+ * @file velocity_trends.cpp
+ * @brief Implementation of the velocity trend models for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "velocity_trends.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+constexpr std::int64_t kSecondsPerDay = 24 * 60 * 60;
+
+/// Longest pause between two reports of one sitting
+constexpr std::chrono::minutes kMaxSittingGap(30);
+
+/**
+ * @brief Floor division (day indexes before the epoch round down)
+ */
+std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+    const std::int64_t quotient = value / divisor;
+    return quotient * divisor > value ? quotient - 1 : quotient;
+}
+
+/**
+ * @brief Position of a day in the weekly cycle
+ */
+std::size_t seasonIndex(std::int64_t day) {
+    const std::int64_t season = static_cast<std::int64_t>(kVelocitySeasonDays);
+    return static_cast<std::size_t>(((day % season) + season) % season);
+}
+
+/// Level, trend and the weekly seasonal offsets, as one vector
+constexpr std::size_t kStateSize = 2 + kVelocitySeasonDays;
+using HoltWintersState = std::array<double, kStateSize>;
+
+/// A linear map of states, stored by column
+using HoltWintersMap = std::array<HoltWintersState, kStateSize>;
+
+/**
+ * @brief Additive Holt-Winters update of level, trend and one seasonal offset
+ */
+void holtWintersStep(const VelocityParameters& parameters, double pages,
+                     double& level, double& trend, double& seasonal) {
+    const double alpha = parameters.levelAlpha;
+    const double beta = parameters.trendBeta;
+    const double previousLevel = level;
+    level = alpha * (pages - seasonal) + (1.0 - alpha) * (level + trend);
+    trend = beta * (level - previousLevel) + (1.0 - beta) * trend;
+    seasonal = parameters.seasonGamma * (pages - level) + (1.0 - parameters.seasonGamma) * seasonal;
+}
+
+/**
+ * @brief Holt-Winters update of a state vector with an idle (zero-page) day
+ */
+void idleStep(const VelocityParameters& parameters, std::size_t season, HoltWintersState& state) {
+    holtWintersStep(parameters, 0.0, state[0], state[1], state[2 + season]);
+}
+
+HoltWintersState applyMap(const HoltWintersMap& map, const HoltWintersState& state) {
+    HoltWintersState result{};
+    for (std::size_t column = 0; column < kStateSize; ++column) {
+        for (std::size_t row = 0; row < kStateSize; ++row) {
+            result[row] += map[column][row] * state[column];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Start of a day as a time point
+ */
+std::chrono::system_clock::time_point dayStart(std::int64_t day, std::int64_t utcOffsetSeconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(day * kSecondsPerDay - utcOffsetSeconds));
+}
+
+} // namespace
+
+// ==== VELOCITY SERIES ====
+
+VelocitySeries::VelocitySeries(const VelocityParameters& parameters)
+    : m_parameters(parameters)
+    , m_pagesPerHour(0.0)
+    , m_hasSpeed(false)
+    , m_level(0.0)
+    , m_trend(0.0)
+    , m_seasonal{}
+    , m_initialized(false)
+    , m_openDay(0)
+    , m_openPages(0)
+    , m_lastClosedDay(0)
+    , m_sessions(0)
+{
+}
+
+/**
+ * @brief Fold a session into the model
+ */
+void VelocitySeries::addSession(std::int64_t day, int pages, double minutes) {
+    pages = std::max(pages, 0);
+    if (minutes > 0.0) {
+        const double speed = pages * 60.0 / minutes;
+        m_pagesPerHour = m_hasSpeed
+                         ? m_parameters.speedAlpha * speed + (1.0 - m_parameters.speedAlpha) * m_pagesPerHour
+                         : speed;
+        m_hasSpeed = true;
+    }
+
+    if (m_sessions == 0) {
+        m_openDay = day;
+    } else if (day > m_openDay) {
+        advanceTo(day);
+    }
+    m_openPages += pages;
+    ++m_sessions;
+}
+
+/**
+ * @brief Close every day before the given one
+ *
+ * Idle days in between are closed with zero pages. Only the ones that
+ * stay in the history are closed one by one; older ones are skipped in
+ * closed form (see skipIdleDays()).
+ */
+void VelocitySeries::advanceTo(std::int64_t day) {
+    if (m_sessions == 0 || day <= m_openDay) {
+        return;
+    }
+    closeDay(m_openDay, m_openPages);
+
+    const std::int64_t idleDays = day - m_openDay - 1;
+    const std::int64_t kept = std::min<std::int64_t>(idleDays, static_cast<std::int64_t>(m_parameters.historyDays));
+    skipIdleDays(m_openDay + 1, idleDays - kept);
+    for (std::int64_t idle = day - kept; idle < day; ++idle) {
+        closeDay(idle, 0.0);
+    }
+    m_lastClosedDay = day - 1;
+    m_openDay = day;
+    m_openPages = 0;
+}
+
+double VelocitySeries::getPagesPerHour() const {
+    return m_pagesPerHour;
+}
+
+double VelocitySeries::getLevel() const {
+    return m_level;
+}
+
+double VelocitySeries::getTrend() const {
+    return m_trend;
+}
+
+double VelocitySeries::getSeasonal(std::int64_t day) const {
+    return m_seasonal[seasonIndex(day)];
+}
+
+int VelocitySeries::getOpenDayPages() const {
+    return m_openPages;
+}
+
+std::uint64_t VelocitySeries::getSessionCount() const {
+    return m_sessions;
+}
+
+/**
+ * @brief Smoothed level of recent closed days, oldest first
+ */
+std::vector<VelocityPoint> VelocitySeries::getHistory(std::int64_t utcOffsetSeconds) const {
+    std::vector<VelocityPoint> points;
+    points.reserve(m_history.size());
+    std::int64_t day = m_lastClosedDay - static_cast<std::int64_t>(m_history.size()) + 1;
+    for (double level : m_history) {
+        points.push_back(VelocityPoint{ dayStart(day++, utcOffsetSeconds), level });
+    }
+    return points;
+}
+
+/**
+ * @brief Predicted pages per day after the last closed day
+ *
+ * The additive Holt-Winters forecast: level, plus the trend times the
+ * distance, plus the weekday's seasonal offset. Never below zero.
+ */
+std::vector<VelocityPoint> VelocitySeries::forecast(std::size_t days, std::int64_t utcOffsetSeconds) const {
+    std::vector<VelocityPoint> points;
+    if (!m_initialized) {
+        return points;
+    }
+    points.reserve(days);
+    for (std::size_t h = 1; h <= days; ++h) {
+        const std::int64_t day = m_lastClosedDay + static_cast<std::int64_t>(h);
+        const double value = m_level + static_cast<double>(h) * m_trend + m_seasonal[seasonIndex(day)];
+        points.push_back(VelocityPoint{ dayStart(day, utcOffsetSeconds), std::max(value, 0.0) });
+    }
+    return points;
+}
+
+/**
+ * @brief Holt-Winters update with the total of one day
+ *
+ * The first day starts the level with no trend and a flat weekly
+ * profile; the profile is learned as the weeks go by.
+ */
+void VelocitySeries::closeDay(std::int64_t day, double pages) {
+    double& seasonal = m_seasonal[seasonIndex(day)];
+    if (!m_initialized) {
+        m_level = pages;
+        m_initialized = true;
+        seasonal = m_parameters.seasonGamma * (pages - m_level) + (1.0 - m_parameters.seasonGamma) * seasonal;
+    } else {
+        holtWintersStep(m_parameters, pages, m_level, m_trend, seasonal);
+    }
+
+    m_lastClosedDay = day;
+    m_history.push_back(m_level);
+    while (m_history.size() > m_parameters.historyDays) {
+        m_history.pop_front();
+    }
+}
+
+/**
+ * @brief Apply count idle days starting at first, without recording them
+ *
+ * With zero pages a day's update is linear in the state, so a week of
+ * idle days is one fixed map; count / 7 weeks are applied by squaring
+ * it, in O(log count) steps, and the remaining days one by one.
+ */
+void VelocitySeries::skipIdleDays(std::int64_t first, std::int64_t count) {
+    if (count <= 0) {
+        return;
+    }
+
+    HoltWintersMap week{};
+    for (std::size_t column = 0; column < kStateSize; ++column) {
+        week[column][column] = 1.0;
+        for (std::int64_t d = 0; d < static_cast<std::int64_t>(kVelocitySeasonDays); ++d) {
+            idleStep(m_parameters, seasonIndex(first + d), week[column]);
+        }
+    }
+
+    HoltWintersState state{};
+    state[0] = m_level;
+    state[1] = m_trend;
+    std::copy(m_seasonal.begin(), m_seasonal.end(), state.begin() + 2);
+
+    const std::int64_t weekLength = static_cast<std::int64_t>(kVelocitySeasonDays);
+    for (std::int64_t weeks = count / weekLength; weeks > 0; weeks /= 2) {
+        if (weeks % 2 != 0) {
+            state = applyMap(week, state);
+        }
+        if (weeks > 1) {
+            HoltWintersMap squared;
+            for (std::size_t column = 0; column < kStateSize; ++column) {
+                squared[column] = applyMap(week, week[column]);
+            }
+            week = squared;
+        }
+    }
+    for (std::int64_t d = count - count % weekLength; d < count; ++d) {
+        idleStep(m_parameters, seasonIndex(first + d), state);
+    }
+
+    m_level = state[0];
+    m_trend = state[1];
+    std::copy(state.begin() + 2, state.end(), m_seasonal.begin());
+}
+
+// ==== VELOCITY TRENDS ====
+
+VelocityTrends::VelocityTrends(const VelocityParameters& parameters)
+    : m_parameters(parameters)
+    , m_overall(parameters)
+{
+}
+
+void VelocityTrends::addSession(const ReadingSession& session) {
+    const std::int64_t day = toDay(session.end);
+    m_overall.addSession(day, session.pages, session.minutes);
+    m_genres.try_emplace(session.genre, m_parameters).first->second.addSession(day, session.pages, session.minutes);
+}
+
+/**
+ * @brief Fold a progress report into the models
+ *
+ * Going back (re-reading, or a corrected page) is not a session; the
+ * book's position simply moves.
+ */
+void VelocityTrends::addReadingEvent(const ReadingEvent& event, const std::string& genre) {
+    auto [it, first] = m_progress.try_emplace(event.bookId, BookProgress{ event.page, event.timestamp });
+    if (first) {
+        return;
+    }
+
+    BookProgress& progress = it->second;
+    const int pages = event.page - progress.page;
+    const auto gap = event.timestamp - progress.time;
+    if (pages > 0 && gap >= std::chrono::system_clock::duration::zero()) {
+        ReadingSession session;
+        session.genre = genre;
+        session.end = event.timestamp;
+        session.pages = pages;
+        if (gap <= kMaxSittingGap) {
+            session.minutes = std::chrono::duration<double, std::ratio<60>>(gap).count();
+        }
+        addSession(session);
+    }
+    progress = BookProgress{ event.page, event.timestamp };
+}
+
+void VelocityTrends::advanceTo(std::chrono::system_clock::time_point now) {
+    const std::int64_t day = toDay(now);
+    m_overall.advanceTo(day);
+    for (auto& [genre, series] : m_genres) {
+        series.advanceTo(day);
+    }
+}
+
+const VelocitySeries& VelocityTrends::getOverall() const {
+    return m_overall;
+}
+
+const VelocitySeries* VelocityTrends::getGenre(const std::string& genre) const {
+    auto it = m_genres.find(genre);
+    return it == m_genres.end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> VelocityTrends::getGenres() const {
+    std::vector<std::string> genres;
+    genres.reserve(m_genres.size());
+    for (const auto& [genre, series] : m_genres) {
+        genres.push_back(genre);
+    }
+    return genres;
+}
+
+std::int64_t VelocityTrends::toDay(std::chrono::system_clock::time_point time) const {
+    const std::int64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+    return floorDiv(seconds + m_parameters.utcOffsetSeconds, kSecondsPerDay);
+}
+
+std::int64_t VelocityTrends::getUtcOffset() const {
+    return m_parameters.utcOffsetSeconds;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file what_if_simulator.cpp
+ * @brief Implementation of the what-if simulator for the Personal Reading Management System (PRMS)
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "what_if_simulator.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+/// Runs per batch (one seed, one task for parallelFor)
+constexpr std::size_t kRunsPerBatch = 256;
+
+/// Rounds the runs are split into, with a progress report after each
+constexpr std::size_t kProgressRounds = 8;
+
+/**
+ * @brief SplitMix64, to derive independent batch seeds from one seed
+ */
+std::uint64_t mixSeed(std::uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Counts of a set of runs, merged into the result
+ */
+struct Tally {
+    std::size_t runs = 0;
+    std::size_t goalMet = 0;
+    std::vector<std::size_t> completedOn; // runs whose pile was done on each day (last slot: never)
+    std::vector<std::size_t> bookFinished;
+    std::vector<std::uint64_t> bookFinishDaySum; // days from the start, summed exactly
+
+    Tally(std::size_t books, std::size_t days)
+        : completedOn(days + 1, 0)
+        , bookFinished(books, 0)
+        , bookFinishDaySum(books, 0)
+    {
+    }
+
+    void add(const Tally& other) {
+        runs += other.runs;
+        goalMet += other.goalMet;
+        for (std::size_t i = 0; i < completedOn.size(); ++i) {
+            completedOn[i] += other.completedOn[i];
+        }
+        for (std::size_t i = 0; i < bookFinished.size(); ++i) {
+            bookFinished[i] += other.bookFinished[i];
+            bookFinishDaySum[i] += other.bookFinishDaySum[i];
+        }
+    }
+};
+
+/**
+ * @brief Simulate one run and add it to a tally
+ *
+ * Every started book is either finished or, with the DNF rate, dropped
+ * after a uniformly drawn share of it. A day has at most one session.
+ */
+void simulateRun(const SimulationInputs& inputs, std::mt19937_64& random, Tally& tally) {
+    std::bernoulli_distribution readsToday(std::clamp(inputs.sessionsPerWeek / 7.0, 0.0, 1.0));
+    std::lognormal_distribution<double> sessionLength(
+        std::log(std::max(inputs.sessionMinutes, 1e-9)) - inputs.sessionMinutesSpread * inputs.sessionMinutesSpread / 2,
+        inputs.sessionMinutesSpread);
+    std::lognormal_distribution<double> speed(-inputs.speedSpread * inputs.speedSpread / 2, inputs.speedSpread);
+    std::bernoulli_distribution abandons(std::clamp(inputs.dnfRate, 0.0, 1.0));
+    std::uniform_real_distribution<double> abandonPoint(0.0, 1.0);
+
+    const std::size_t books = inputs.bookMinutes.size();
+    const std::int64_t goalIndex = inputs.goal.byDay - inputs.startDay;
+    std::size_t current = 0;
+    double left = 0.0; // minutes left of the current book (until finished or dropped)
+    bool dropping = false; // the current book will be abandoned
+    int finishedByGoal = 0;
+
+    auto startBook = [&]() {
+        while (current < books) {
+            dropping = abandons(random);
+            left = std::max(inputs.bookMinutes[current], 0.0) * (dropping ? abandonPoint(random) : 1.0);
+            if (left > 0.0 || !dropping) {
+                return;
+            }
+            ++current; // abandoned before the first page
+        }
+    };
+    startBook();
+
+    std::size_t day = 0;
+    for (; day < inputs.horizonDays && current < books; ++day) {
+        if (!readsToday(random)) {
+            continue;
+        }
+        double budget = sessionLength(random) * speed(random); // minutes at the usual speed
+        while (budget > 0.0 && current < books) {
+            const double used = std::min(budget, left);
+            budget -= used;
+            left -= used;
+            if (left > 0.0) {
+                break;
+            }
+            if (!dropping) {
+                ++tally.bookFinished[current];
+                tally.bookFinishDaySum[current] += day;
+                finishedByGoal += static_cast<std::int64_t>(day) <= goalIndex;
+            }
+            ++current;
+            startBook();
+        }
+    }
+
+    ++tally.runs;
+    tally.goalMet += finishedByGoal >= inputs.goal.books;
+    if (current >= books) {
+        tally.completedOn[day == 0 ? 0 : day - 1]++; // the day the last book was closed
+    } else {
+        tally.completedOn.back()++;
+    }
+}
+
+/**
+ * @brief Turn a tally into a result
+ */
+SimulationResult summarize(const SimulationInputs& inputs, const Tally& tally, bool complete) {
+    SimulationResult result;
+    result.runs = tally.runs;
+    result.complete = complete;
+    if (tally.runs == 0) {
+        return result;
+    }
+    const double runs = static_cast<double>(tally.runs);
+    result.goalProbability = static_cast<double>(tally.goalMet) / runs;
+
+    result.completionByDay.resize(inputs.horizonDays);
+    std::size_t done = 0;
+    for (std::size_t day = 0; day < inputs.horizonDays; ++day) {
+        done += tally.completedOn[day];
+        result.completionByDay[day] = static_cast<double>(done) / runs;
+        const std::int64_t absolute = inputs.startDay + static_cast<std::int64_t>(day);
+        if (result.completionP10 == kNotScheduled && result.completionByDay[day] >= 0.1) {
+            result.completionP10 = absolute;
+        }
+        if (result.completionP50 == kNotScheduled && result.completionByDay[day] >= 0.5) {
+            result.completionP50 = absolute;
+        }
+        if (result.completionP90 == kNotScheduled && result.completionByDay[day] >= 0.9) {
+            result.completionP90 = absolute;
+        }
+    }
+
+    const std::size_t books = tally.bookFinished.size();
+    result.bookFinishProbability.resize(books);
+    result.bookMeanFinishDay.resize(books);
+    for (std::size_t i = 0; i < books; ++i) {
+        result.bookFinishProbability[i] = static_cast<double>(tally.bookFinished[i]) / runs;
+        result.bookMeanFinishDay[i] = tally.bookFinished[i] == 0
+                                      ? -1.0
+                                      : static_cast<double>(inputs.startDay) +
+                                        static_cast<double>(tally.bookFinishDaySum[i]) /
+                                        static_cast<double>(tally.bookFinished[i]);
+    }
+    return result;
+}
+
+} // namespace
+
+// ==== SIMULATION INPUTS ====
+
+bool SimulationInputs::operator==(const SimulationInputs& other) const {
+    return bookIds == other.bookIds && bookMinutes == other.bookMinutes &&
+           sessionsPerWeek == other.sessionsPerWeek && sessionMinutes == other.sessionMinutes &&
+           sessionMinutesSpread == other.sessionMinutesSpread && speedSpread == other.speedSpread &&
+           dnfRate == other.dnfRate && goal.books == other.goal.books && goal.byDay == other.goal.byDay &&
+           startDay == other.startDay && horizonDays == other.horizonDays && runs == other.runs &&
+           seed == other.seed;
+}
+
+bool SimulationInputs::operator!=(const SimulationInputs& other) const {
+    return !(*this == other);
+}
+
+// ==== WHAT-IF SIMULATOR ====
+
+WhatIfSimulator::WhatIfSimulator() = default;
+
+/**
+ * @brief Simulate, or return the cached result for the same inputs
+ *
+ * Batch b always uses seed mixSeed(seed + b) and batches are merged by
+ * adding counts, so the result is the same on any number of cores.
+ */
+SimulationResult WhatIfSimulator::run(const SimulationInputs& inputs, const ProgressCallback& progress) {
+    if (std::optional<SimulationResult> cached = getCached(inputs)) {
+        if (progress) {
+            progress(*cached);
+        }
+        return *cached;
+    }
+
+    const std::size_t books = inputs.bookMinutes.size();
+    const std::size_t batches = (inputs.runs + kRunsPerBatch - 1) / kRunsPerBatch;
+    const std::size_t batchesPerRound = std::max<std::size_t>((batches + kProgressRounds - 1) / kProgressRounds, 1);
+
+    Tally total(books, inputs.horizonDays);
+    for (std::size_t first = 0; first < batches; first += batchesPerRound) {
+        const std::size_t count = std::min(batchesPerRound, batches - first);
+        std::vector<Tally> tallies(getWorkerCount(count), Tally(books, inputs.horizonDays));
+        parallelFor(count, [&](std::size_t worker, std::size_t task) {
+            const std::size_t batch = first + task;
+            std::mt19937_64 random(mixSeed(inputs.seed + batch));
+            const std::size_t runs = std::min(kRunsPerBatch, inputs.runs - batch * kRunsPerBatch);
+            for (std::size_t r = 0; r < runs; ++r) {
+                simulateRun(inputs, random, tallies[worker]);
+            }
+        });
+        for (const Tally& tally : tallies) {
+            total.add(tally);
+        }
+
+        const bool complete = first + count >= batches;
+        if (progress && !complete && !progress(summarize(inputs, total, false))) {
+            return summarize(inputs, total, false);
+        }
+    }
+
+    SimulationResult result = summarize(inputs, total, true);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cachedInputs = inputs;
+        m_cachedResult = result;
+    }
+    if (progress) {
+        progress(result);
+    }
+    return result;
+}
+
+std::optional<SimulationResult> WhatIfSimulator::getCached(const SimulationInputs& inputs) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cachedInputs && *m_cachedInputs == inputs) {
+        return m_cachedResult;
+    }
+    return std::nullopt;
+}
+
+void WhatIfSimulator::invalidate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cachedInputs.reset();
+}
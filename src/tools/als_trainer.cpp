@@ -0,0 +1,475 @@
+/**
+ * @file als_trainer.cpp
+ * @brief Offline collaborative-filtering trainer (prms_als)
+ *
+ * Trains a matrix factorization of a public ratings dump on local disk
+ * (for example Book-Crossing or a Goodreads export) with alternating
+ * least squares, and writes the item factors as a factor file that PRMS
+ * memory-maps to score recommendations (see factor_file.h). Nothing is
+ * downloaded and nothing about the user's library is read.
+ *
+ * The dump is a text file with one rating per line, "user,isbn,rating";
+ * commas, semicolons or tabs separate the fields, which may be quoted.
+ * Lines that do not parse (such as a header) are skipped, as are zero
+ * ratings, which dumps use for "seen but not rated".
+ *
+ * ALS alternates between solving every user given the items and every
+ * item given the users. Each side is a set of independent rank x rank
+ * ridge regressions (weighted-lambda regularization), solved by Cholesky
+ * in blocks of rows spread over all cores.
+ *
+ * With --quantized, the factors are also product-quantized (see
+ * quantized_factors.h) into a second, 4-16x smaller file.
+ *
+ * Usage:
+ *
+ *     prms_als --input FILE --output FILE [--rank K] [--iterations N]
+ *              [--lambda L] [--min-ratings M] [--seed S]
+ *              [--quantized FILE] [--subspace-dims D]
+ *
+ * Built only with -DPRMS_BUILD_ALS_TRAINER=ON.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "factor_file.h"
+#include "parallel.h"
+#include "quantized_factors.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// ==== CONFIGURATION ====
+
+/**
+ * @brief Command line options
+ */
+struct TrainerOptions {
+    std::string inputPath;
+    std::string outputPath;
+    std::uint32_t rank = 32;
+    int iterations = 10;
+    double lambda = 0.05; // scaled by each row's rating count
+    std::size_t minRatings = 2; // items rated less often are dropped
+    std::uint64_t seed = 1;
+    std::string quantizedPath; // empty: no quantized file
+    std::uint32_t subspaceDims = 4; // 16x smaller than the floats
+};
+
+/// Rows solved per parallel task
+constexpr std::size_t kRowsPerBlock = 512;
+
+/**
+ * @brief Parse the command line
+ * @throws std::invalid_argument on unknown or malformed options
+ */
+TrainerOptions parseOptions(int argc, char* argv[]) {
+    TrainerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+        const std::string value = argv[++i];
+        if (arg == "--input") {
+            options.inputPath = value;
+        } else if (arg == "--output") {
+            options.outputPath = value;
+        } else if (arg == "--rank") {
+            options.rank = static_cast<std::uint32_t>(std::stoul(value));
+        } else if (arg == "--iterations") {
+            options.iterations = std::stoi(value);
+        } else if (arg == "--lambda") {
+            options.lambda = std::stod(value);
+        } else if (arg == "--min-ratings") {
+            options.minRatings = std::stoul(value);
+        } else if (arg == "--seed") {
+            options.seed = std::stoull(value);
+        } else if (arg == "--quantized") {
+            options.quantizedPath = value;
+        } else if (arg == "--subspace-dims") {
+            options.subspaceDims = static_cast<std::uint32_t>(std::stoul(value));
+        } else {
+            throw std::invalid_argument("Unknown option " + arg);
+        }
+    }
+    if (options.inputPath.empty() || options.outputPath.empty() || options.rank == 0 ||
+        options.iterations < 1 || options.lambda <= 0.0) {
+        throw std::invalid_argument("Need --input, --output, --rank >= 1, --iterations >= 1 and --lambda > 0");
+    }
+    if (!options.quantizedPath.empty() && (options.subspaceDims == 0 || options.rank % options.subspaceDims != 0)) {
+        throw std::invalid_argument("--subspace-dims must divide --rank");
+    }
+    return options;
+}
+
+// ==== RATINGS ====
+
+/**
+ * @brief One side of the rating matrix in compressed-row form
+ *
+ * Row r rates columns[starts[r]..starts[r + 1]) with the matching values.
+ */
+struct SparseRows {
+    std::vector<std::size_t> starts;
+    std::vector<std::uint32_t> columns;
+    std::vector<float> values;
+
+    std::size_t getRowCount() const {
+        return starts.empty() ? 0 : starts.size() - 1;
+    }
+};
+
+/**
+ * @brief The parsed dump
+ */
+struct Ratings {
+    std::vector<std::string> itemKeys;
+    std::vector<std::uint32_t> users; // one entry per rating
+    std::vector<std::uint32_t> items;
+    std::vector<float> values;
+    std::size_t userCount = 0;
+    double mean = 0.0;
+};
+
+/**
+ * @brief Split a dump line into its fields, dropping quotes
+ */
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (char c : line) {
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (!quoted && (c == ',' || c == ';' || c == '\t')) {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back().push_back(c);
+        }
+    }
+    return fields;
+}
+
+/**
+ * @brief Read the dump, keeping items with enough ratings
+ * @throws std::runtime_error if the file cannot be read or has no ratings
+ */
+Ratings readRatings(const TrainerOptions& options) {
+    std::ifstream in(options.inputPath);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + options.inputPath);
+    }
+
+    std::unordered_map<std::string, std::uint32_t> userIds;
+    std::unordered_map<std::string, std::uint32_t> itemIds;
+    Ratings all;
+    std::string line;
+    std::size_t skipped = 0;
+    while (std::getline(in, line)) {
+        const std::vector<std::string> fields = splitFields(line);
+        if (fields.size() < 3) {
+            skipped += !line.empty();
+            continue;
+        }
+        const std::string key = normalizeIsbn(fields[1]);
+        char* end = nullptr;
+        const double rating = std::strtod(fields[2].c_str(), &end);
+        if (key.empty() || fields[0].empty() || end == fields[2].c_str() || !std::isfinite(rating)) {
+            ++skipped;
+            continue;
+        }
+        if (rating == 0.0) {
+            continue; // implicit: seen, not rated
+        }
+        auto user = userIds.emplace(fields[0], static_cast<std::uint32_t>(userIds.size())).first;
+        auto item = itemIds.emplace(key, static_cast<std::uint32_t>(all.itemKeys.size()));
+        if (item.second) {
+            all.itemKeys.push_back(key);
+        }
+        all.users.push_back(user->second);
+        all.items.push_back(item.first->second);
+        all.values.push_back(static_cast<float>(rating));
+    }
+    if (skipped > 0) {
+        std::cerr << "Skipped " << skipped << " malformed lines\n";
+    }
+
+    // Drop rarely rated items (their factors would be noise) and renumber
+    std::vector<std::size_t> counts(all.itemKeys.size(), 0);
+    for (std::uint32_t item : all.items) {
+        ++counts[item];
+    }
+    std::vector<std::int64_t> newItem(all.itemKeys.size(), -1);
+    Ratings kept;
+    for (std::size_t i = 0; i < all.itemKeys.size(); ++i) {
+        if (counts[i] >= options.minRatings) {
+            newItem[i] = static_cast<std::int64_t>(kept.itemKeys.size());
+            kept.itemKeys.push_back(all.itemKeys[i]);
+        }
+    }
+    std::vector<std::int64_t> newUser(userIds.size(), -1);
+    double sum = 0.0;
+    for (std::size_t r = 0; r < all.values.size(); ++r) {
+        if (newItem[all.items[r]] < 0) {
+            continue;
+        }
+        std::int64_t& user = newUser[all.users[r]];
+        if (user < 0) {
+            user = static_cast<std::int64_t>(kept.userCount++);
+        }
+        kept.users.push_back(static_cast<std::uint32_t>(user));
+        kept.items.push_back(static_cast<std::uint32_t>(newItem[all.items[r]]));
+        kept.values.push_back(all.values[r]);
+        sum += all.values[r];
+    }
+    if (kept.values.empty()) {
+        throw std::runtime_error("No usable ratings in " + options.inputPath);
+    }
+    kept.mean = sum / static_cast<double>(kept.values.size());
+    return kept;
+}
+
+/**
+ * @brief Group the mean-centered ratings by row
+ *
+ * @param rows Row of each rating (users or items)
+ * @param columns Column of each rating
+ * @param rowCount Number of rows
+ */
+SparseRows groupByRow(const std::vector<std::uint32_t>& rows, const std::vector<std::uint32_t>& columns,
+                      const std::vector<float>& values, std::size_t rowCount, double mean) {
+    SparseRows grouped;
+    grouped.starts.assign(rowCount + 1, 0);
+    for (std::uint32_t row : rows) {
+        ++grouped.starts[row + 1];
+    }
+    for (std::size_t r = 0; r < rowCount; ++r) {
+        grouped.starts[r + 1] += grouped.starts[r];
+    }
+    grouped.columns.resize(rows.size());
+    grouped.values.resize(rows.size());
+    std::vector<std::size_t> next(grouped.starts.begin(), grouped.starts.end() - 1);
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const std::size_t slot = next[rows[i]]++;
+        grouped.columns[slot] = columns[i];
+        grouped.values[slot] = static_cast<float>(values[i] - mean);
+    }
+    return grouped;
+}
+
+// ==== SOLVER ====
+
+/**
+ * @brief Solve A x = b in place for a symmetric positive definite A
+ *
+ * A (n x n, row-major) is overwritten by its Cholesky factor and b by x.
+ * @return False if A is not positive definite
+ */
+bool solveCholesky(std::vector<double>& a, std::vector<double>& b, std::size_t n) {
+    for (std::size_t j = 0; j < n; ++j) {
+        double diagonal = a[j * n + j];
+        for (std::size_t k = 0; k < j; ++k) {
+            diagonal -= a[j * n + k] * a[j * n + k];
+        }
+        if (diagonal <= 0.0) {
+            return false;
+        }
+        diagonal = std::sqrt(diagonal);
+        a[j * n + j] = diagonal;
+        for (std::size_t i = j + 1; i < n; ++i) {
+            double value = a[i * n + j];
+            for (std::size_t k = 0; k < j; ++k) {
+                value -= a[i * n + k] * a[j * n + k];
+            }
+            a[i * n + j] = value / diagonal;
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) { // L y = b
+        for (std::size_t k = 0; k < i; ++k) {
+            b[i] -= a[i * n + k] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    for (std::size_t i = n; i-- > 0;) { // L^T x = y
+        for (std::size_t k = i + 1; k < n; ++k) {
+            b[i] -= a[k * n + i] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    return true;
+}
+
+/**
+ * @brief Per-worker normal-equation buffers
+ */
+struct SolverScratch {
+    std::vector<double> matrix;
+    std::vector<double> rhs;
+};
+
+/**
+ * @brief Solve every row of one side given the other side's factors
+ *
+ * Row r minimizes sum (rating - x_r . y_c)^2 + lambda * n_r * |x_r|^2
+ * over its n_r ratings. Rows are split into blocks, one parallel task
+ * each, and every worker reuses its own buffers.
+ */
+void solveSide(const SparseRows& rows, const std::vector<float>& fixed, std::vector<float>& solved,
+               std::uint32_t rank, double lambda, std::vector<SolverScratch>& scratch) {
+    const std::size_t rowCount = rows.getRowCount();
+    const std::size_t blocks = (rowCount + kRowsPerBlock - 1) / kRowsPerBlock;
+    parallelFor(blocks, [&](std::size_t worker, std::size_t block) {
+        std::vector<double>& a = scratch[worker].matrix;
+        std::vector<double>& b = scratch[worker].rhs;
+        const std::size_t end = std::min(rowCount, (block + 1) * kRowsPerBlock);
+        for (std::size_t row = block * kRowsPerBlock; row < end; ++row) {
+            float* x = &solved[row * rank];
+            const std::size_t first = rows.starts[row];
+            const std::size_t count = rows.starts[row + 1] - first;
+            if (count == 0) {
+                std::fill(x, x + rank, 0.0f);
+                continue;
+            }
+            std::fill(a.begin(), a.end(), 0.0);
+            std::fill(b.begin(), b.end(), 0.0);
+            for (std::size_t r = first; r < first + count; ++r) {
+                const float* y = &fixed[static_cast<std::size_t>(rows.columns[r]) * rank];
+                for (std::uint32_t i = 0; i < rank; ++i) {
+                    b[i] += rows.values[r] * y[i];
+                    for (std::uint32_t j = 0; j <= i; ++j) {
+                        a[i * rank + j] += static_cast<double>(y[i]) * y[j]; // lower triangle only
+                    }
+                }
+            }
+            for (std::uint32_t i = 0; i < rank; ++i) {
+                a[i * rank + i] += lambda * static_cast<double>(count);
+            }
+            if (solveCholesky(a, b, rank)) {
+                std::copy(b.begin(), b.end(), x);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Root mean square error of the model on the training ratings
+ */
+double computeRmse(const SparseRows& byUser, const std::vector<float>& userFactors,
+                   const std::vector<float>& itemFactors, std::uint32_t rank) {
+    const std::size_t rowCount = byUser.getRowCount();
+    const std::size_t blocks = (rowCount + kRowsPerBlock - 1) / kRowsPerBlock;
+    std::vector<double> sums(getWorkerCount(blocks), 0.0);
+    parallelFor(blocks, [&](std::size_t worker, std::size_t block) {
+        const std::size_t end = std::min(rowCount, (block + 1) * kRowsPerBlock);
+        for (std::size_t user = block * kRowsPerBlock; user < end; ++user) {
+            const float* x = &userFactors[user * rank];
+            for (std::size_t r = byUser.starts[user]; r < byUser.starts[user + 1]; ++r) {
+                const float* y = &itemFactors[static_cast<std::size_t>(byUser.columns[r]) * rank];
+                double prediction = 0.0;
+                for (std::uint32_t d = 0; d < rank; ++d) {
+                    prediction += static_cast<double>(x[d]) * y[d];
+                }
+                const double error = byUser.values[r] - prediction;
+                sums[worker] += error * error;
+            }
+        }
+    });
+    double total = 0.0;
+    for (double sum : sums) {
+        total += sum;
+    }
+    return byUser.values.empty() ? 0.0 : std::sqrt(total / static_cast<double>(byUser.values.size()));
+}
+
+} // namespace
+
+/**
+ * @brief Run the trainer
+ * @return 0 on success, 2 on errors
+ */
+int main(int argc, char* argv[]) {
+    TrainerOptions options;
+    Ratings ratings;
+    try {
+        options = parseOptions(argc, argv);
+        ratings = readRatings(options);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    const std::size_t itemCount = ratings.itemKeys.size();
+    const std::uint32_t rank = options.rank;
+    std::cout << ratings.values.size() << " ratings, " << ratings.userCount << " users, "
+              << itemCount << " items, mean " << std::setprecision(3) << ratings.mean << "\n";
+
+    const SparseRows byUser = groupByRow(ratings.users, ratings.items, ratings.values,
+                                         ratings.userCount, ratings.mean);
+    const SparseRows byItem = groupByRow(ratings.items, ratings.users, ratings.values,
+                                         itemCount, ratings.mean);
+    ratings.users.clear();
+    ratings.items.clear();
+    ratings.values.clear();
+
+    std::mt19937_64 random(options.seed);
+    std::normal_distribution<float> initial(0.0f, 0.1f / std::sqrt(static_cast<float>(rank)));
+    std::vector<float> userFactors(ratings.userCount * rank, 0.0f);
+    std::vector<float> itemFactors(itemCount * rank);
+    for (float& value : itemFactors) {
+        value = initial(random);
+    }
+
+    std::vector<SolverScratch> scratch(getWorkerCount(
+        (std::max(ratings.userCount, itemCount) + kRowsPerBlock - 1) / kRowsPerBlock));
+    for (SolverScratch& buffers : scratch) {
+        buffers.matrix.resize(static_cast<std::size_t>(rank) * rank);
+        buffers.rhs.resize(rank);
+    }
+
+    std::cout << std::fixed;
+    for (int iteration = 1; iteration <= options.iterations; ++iteration) {
+        const auto start = std::chrono::steady_clock::now();
+        solveSide(byUser, itemFactors, userFactors, rank, options.lambda, scratch);
+        solveSide(byItem, userFactors, itemFactors, rank, options.lambda, scratch);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "iteration " << std::setw(3) << iteration << "  rmse " << std::setprecision(4)
+                  << computeRmse(byUser, userFactors, itemFactors, rank) << "  "
+                  << std::setprecision(2) << seconds << " s" << std::endl;
+    }
+
+    if (!writeFactorFile(options.outputPath, rank, static_cast<float>(ratings.mean),
+                         ratings.itemKeys, itemFactors)) {
+        std::cerr << "Cannot write " << options.outputPath << "\n";
+        return 2;
+    }
+    std::cout << "Wrote " << itemCount << " item vectors to " << options.outputPath << "\n";
+
+    if (!options.quantizedPath.empty()) {
+        try {
+            const FactorFile factors(options.outputPath);
+            if (!writeQuantizedFactors(options.quantizedPath, factors, options.subspaceDims,
+                                       options.iterations, options.seed)) {
+                std::cerr << "Cannot write " << options.quantizedPath << "\n";
+                return 2;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 2;
+        }
+        std::cout << "Wrote " << itemCount << " quantized vectors (" << rank / options.subspaceDims
+                  << " bytes each) to " << options.quantizedPath << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,509 @@
+/**
+ * @file scale_harness.cpp
+ * @brief Scalability harness for huge libraries (prms_scale)
+ *
+ * NFR-002 asks for 10,000 books; we aim for 1M books and 50M reading
+ * sessions. This tool generates synthetic libraries at exponentially
+ * growing sizes and times the operations users wait on at every size:
+ * import, startup, search, filter, sort, export and chart data. It
+ * prints the scaling curves as a log-log plot (and optionally a CSV
+ * for external plotting), fits the growth exponent of each operation
+ * and exits with status 1 if any operation grows faster than its
+ * declared budget.
+ *
+ * Usage:
+ *
+ *     prms_scale [--min N] [--max N] [--factor F] [--sessions-per-book S]
+ *                [--repeats R] [--csv FILE] [--memory-budget SPEC]
+ *
+ * SPEC uses MemoryAccounting::setBudgets() syntax ("sort_keys=64M").
+ * The sort is timed on C.UTF-8 sort key columns, and their memory is
+ * printed for every size. The memory report of the largest library is
+ * printed at the end.
+ *
+ * Built only with -DPRMS_BUILD_SCALE_HARNESS=ON.
+ *
+ * @author Shahzaib Ahmed
+ * @date October 18, 2026
+ */
+
+#include "book.h"
+#include "book_export.h"
+#include "book_query.h"
+#include "book_table.h"
+#include "book_top_k.h"
+#include "database.h"
+#include "memory_budget.h"
+#include "reading_event.h"
+#include "sort_key.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ==== CONFIGURATION ====
+
+/**
+ * @brief Command line options
+ */
+struct HarnessOptions {
+    std::size_t minBooks = 1000;
+    std::size_t maxBooks = 1000000;
+    double factor = 4.0; // growth between two library sizes
+    std::size_t sessionsPerBook = 5; // 50 matches the 1M books / 50M sessions target
+    int repeats = 3; // in-memory operations keep their best time
+    std::string csvPath; // empty: no CSV
+    std::string memoryBudget; // budget spec, empty: unlimited
+};
+
+/**
+ * @brief The declared growth budget of one operation
+ *
+ * maxExponent bounds the slope of log(time) over log(size): 1.0 is
+ * linear, and the headroom above it covers n log n sorts, cache effects
+ * and timer noise.
+ */
+struct OperationBudget {
+    const char* name;
+    char symbol; // marker in the plot
+    double maxExponent;
+};
+
+const OperationBudget kBudgets[] = {
+    { "import",  'I', 1.25 }, // books and sessions into SQLite (B-tree inserts)
+    { "startup", 'U', 1.20 }, // load the books and build the in-memory table
+    { "search",  'S', 1.15 }, // exact author lookup
+    { "filter",  'F', 1.15 }, // state + page range + genre
+    { "sort",    'O', 1.30 }, // collated title order
+    { "export",  'E', 1.15 }, // CSV of the whole library
+    { "chart",   'C', 1.15 }, // completions per month and top books
+};
+
+/// Locale of the sort key columns the sort is timed on
+constexpr const char* kSortLocale = "C.UTF-8";
+
+/// Timings below this are dominated by noise and left out of the fit
+constexpr double kNoiseFloorMs = 2.0;
+
+/// An operation taking longer than this at any size is reported (never fails)
+constexpr double kInteractiveMs = 100.0;
+
+/**
+ * @brief Parse the command line
+ * @throws std::invalid_argument on unknown or malformed options
+ */
+HarnessOptions parseOptions(int argc, char* argv[]) {
+    HarnessOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+        const std::string value = argv[++i];
+        if (arg == "--min") {
+            options.minBooks = std::stoul(value);
+        } else if (arg == "--max") {
+            options.maxBooks = std::stoul(value);
+        } else if (arg == "--factor") {
+            options.factor = std::stod(value);
+        } else if (arg == "--sessions-per-book") {
+            options.sessionsPerBook = std::stoul(value);
+        } else if (arg == "--repeats") {
+            options.repeats = std::stoi(value);
+        } else if (arg == "--csv") {
+            options.csvPath = value;
+        } else if (arg == "--memory-budget") {
+            options.memoryBudget = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + arg);
+        }
+    }
+    if (options.minBooks == 0 || options.maxBooks < options.minBooks ||
+        options.factor <= 1.0 || options.repeats < 1) {
+        throw std::invalid_argument("Need 0 < --min <= --max, --factor > 1 and --repeats >= 1");
+    }
+    return options;
+}
+
+// ==== LIBRARY GENERATION ====
+
+/**
+ * @brief Build a synthetic library with realistic value distributions
+ *
+ * Few genres, a few hundred publishers, authors with several books each
+ * and a mix of unread, in-progress and completed books. The generator is
+ * seeded, so every run measures the same data.
+ */
+std::vector<Book> generateLibrary(std::size_t count) {
+    static const char* const kWords[] = {
+        "shadow", "river", "empire", "garden", "silent", "winter", "stone", "glass",
+        "night", "crown", "hollow", "light", "iron", "sea", "last", "golden"
+    };
+    static const char* const kGenres[] = {
+        "Fiction", "Fantasy", "Science Fiction", "Mystery", "History", "Biography",
+        "Poetry", "Science", "Philosophy", "Romance", "Thriller", "Travel"
+    };
+    const std::size_t authorCount = std::max<std::size_t>(1, count / 8);
+    const auto epoch = std::chrono::system_clock::time_point(std::chrono::seconds(1262304000));
+
+    std::mt19937 rng(20261018);
+    std::vector<Book> books;
+    books.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string title = std::string(kWords[rng() % 16]) + " " + kWords[rng() % 16] + " " +
+                            std::to_string(i);
+        title[0] = static_cast<char>(title[0] - 'a' + 'A');
+        Book book(title, "Author " + std::to_string(rng() % authorCount), "",
+                  static_cast<int>(80 + rng() % 900));
+        book.setGenre(kGenres[rng() % 12]);
+        book.setPublisher("Publisher " + std::to_string(rng() % 400));
+        book.setYear(static_cast<int>(1900 + rng() % 126));
+
+        const unsigned state = rng() % 3;
+        if (state > 0) {
+            const auto started = epoch + std::chrono::hours(rng() % (24 * 365 * 15));
+            book.setStartDate(started);
+            book.setCurrentPage(state == 2 ? book.getPageCount()
+                                           : static_cast<int>(1 + rng() % book.getPageCount()));
+            if (state == 2) {
+                book.setCompletionDate(started + std::chrono::hours(24 + rng() % (24 * 60)));
+            }
+        }
+        books.push_back(std::move(book));
+    }
+    return books;
+}
+
+// ==== MEASUREMENT ====
+
+/**
+ * @brief Time one run of an operation in milliseconds
+ */
+double timeOnce(const std::function<void()>& operation) {
+    const auto start = std::chrono::steady_clock::now();
+    operation();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Best time of several runs in milliseconds
+ */
+double timeBest(int repeats, const std::function<void()>& operation) {
+    double best = timeOnce(operation);
+    for (int i = 1; i < repeats; ++i) {
+        best = std::min(best, timeOnce(operation));
+    }
+    return best;
+}
+
+/**
+ * @brief Measure every operation on a library of one size
+ *
+ * @param size Number of books
+ * @param options Harness options
+ * @param memoryReport Set to the memory report with the library loaded
+ * @param keyBytes Set to the memory of the sort key columns
+ * @return Milliseconds per operation, by name
+ * @throws std::runtime_error if a database step fails or the sort
+ *         locale is not available
+ */
+std::map<std::string, double> measureSize(std::size_t size, const HarnessOptions& options,
+                                          std::string& memoryReport, std::int64_t& keyBytes) {
+    std::map<std::string, double> times;
+    const std::vector<Book> library = generateLibrary(size);
+    const std::filesystem::path dbPath = std::filesystem::temp_directory_path() /
+                                         ("prms_scale_" + std::to_string(size) + ".db");
+    std::filesystem::remove(dbPath);
+
+    // Import: books first, then their reading sessions, one transaction each
+    times["import"] = timeOnce([&]() {
+        Database db(dbPath.string());
+        if (!db.initialize() || !db.beginTransaction()) {
+            throw std::runtime_error("import: " + db.getLastError());
+        }
+        std::vector<int> ids;
+        ids.reserve(library.size());
+        for (const Book& book : library) {
+            ids.push_back(db.addBook(book));
+        }
+        if (!db.commitTransaction()) {
+            throw std::runtime_error("import: " + db.getLastError());
+        }
+
+        std::mt19937 rng(static_cast<unsigned>(size));
+        std::vector<ReadingEvent> sessions;
+        sessions.reserve(ids.size() * options.sessionsPerBook);
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            const Book& book = library[i];
+            for (std::size_t s = 0; s < options.sessionsPerBook; ++s) {
+                ReadingEvent event;
+                event.bookId = ids[i];
+                event.page = static_cast<int>(rng() % (book.getCurrentPage() + 1));
+                event.timestamp = std::chrono::system_clock::time_point(
+                    std::chrono::seconds(1262304000 + rng() % 473040000));
+                sessions.push_back(event);
+            }
+        }
+        if (!db.beginTransaction() || !db.applyReadingEvents(sessions) || !db.commitTransaction()) {
+            throw std::runtime_error("import sessions: " + db.getLastError());
+        }
+    });
+
+    // Startup: open the database and build the in-memory table
+    BookTable table;
+    times["startup"] = timeOnce([&]() {
+        Database db(dbPath.string());
+        if (!db.initialize()) {
+            throw std::runtime_error("startup: " + db.getLastError());
+        }
+        table.load(db.loadAllBooks(kCoreBookFields));
+    });
+    std::filesystem::remove(dbPath);
+
+    // The app sorts on collated keys; without them collatedOrder() falls
+    // back to byte order and the sort timing would not be representative
+    table.setSortKeyGenerator(std::make_shared<SortKeyGenerator>(kSortLocale));
+    keyBytes = MemoryAccounting::global().getBytes(MemorySubsystem::SortKeys);
+
+    const std::shared_ptr<const BookTableSnapshot> snapshot = table.snapshot();
+    volatile std::size_t sink = 0; // keeps results alive so nothing is optimized away
+
+    BookFilter byAuthor;
+    byAuthor.author = library[size / 2].getAuthor();
+    const BookQuery search(byAuthor);
+    times["search"] = timeBest(options.repeats, [&]() { sink = sink + search.count(*snapshot); });
+
+    BookFilter filter;
+    filter.state = ReadingState::InProgress;
+    filter.pageCount = PageRange{ 200, 600 };
+    filter.genre = "Fantasy";
+    const BookQuery filtered(filter);
+    times["filter"] = timeBest(options.repeats, [&]() { sink = sink + filtered.count(*snapshot); });
+
+    times["sort"] = timeBest(options.repeats, [&]() {
+        sink = sink + collatedOrder(*snapshot, CollatedOrder::Title).size();
+    });
+
+    times["export"] = timeBest(options.repeats, [&]() {
+        std::ostringstream csv;
+        writeBooksCsv(csv, snapshot->toBooks());
+        sink = sink + csv.tellp();
+    });
+
+    // Chart data: completions per month (the history chart) and top books
+    times["chart"] = timeBest(options.repeats, [&]() {
+        std::map<std::int64_t, std::size_t> perMonth;
+        for (std::size_t c = 0; c < snapshot->getChunkCount(); ++c) {
+            for (std::int64_t date : snapshot->getChunk(c).completionDates) {
+                if (date != kNoDate) {
+                    ++perMonth[date / (30 * 24 * 3600)];
+                }
+            }
+        }
+        TopKQuery longest;
+        longest.metric = TopKMetric::PageCount;
+        longest.state = ReadingState::Completed;
+        sink = sink + perMonth.size() + topBooks(*snapshot, longest).size();
+    });
+
+    memoryReport = MemoryAccounting::global().formatReport();
+    return times;
+}
+
+// ==== REPORTING ====
+
+/**
+ * @brief Least-squares slope of log(time) over log(size)
+ *
+ * @param sizes Library sizes
+ * @param times Matching times in milliseconds
+ * @param exponent Set to the slope
+ * @return False if fewer than two timings are above the noise floor
+ */
+bool fitExponent(const std::vector<std::size_t>& sizes, const std::vector<double>& times,
+                 double& exponent) {
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        if (times[i] >= kNoiseFloorMs) {
+            xs.push_back(std::log(static_cast<double>(sizes[i])));
+            ys.push_back(std::log(times[i]));
+        }
+    }
+    if (xs.size() < 2) {
+        return false;
+    }
+
+    const double n = static_cast<double>(xs.size());
+    double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        sumX += xs[i];
+        sumY += ys[i];
+        sumXX += xs[i] * xs[i];
+        sumXY += xs[i] * ys[i];
+    }
+    exponent = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+    return true;
+}
+
+/**
+ * @brief Draw the scaling curves as a log-log character plot
+ */
+void plotCurves(std::ostream& out, const std::vector<std::size_t>& sizes,
+                const std::map<std::string, std::vector<double>>& times) {
+    constexpr int kWidth = 64;
+    constexpr int kHeight = 20;
+
+    double low = 1e300, high = 0;
+    for (const auto& entry : times) {
+        for (double ms : entry.second) {
+            low = std::min(low, std::max(ms, 0.01));
+            high = std::max(high, std::max(ms, 0.01));
+        }
+    }
+    const double logLow = std::log10(low);
+    const double logHigh = std::max(std::log10(high), logLow + 1.0);
+    const double sizeLow = std::log10(static_cast<double>(sizes.front()));
+    const double sizeHigh = std::max(std::log10(static_cast<double>(sizes.back())), sizeLow + 1.0);
+
+    std::vector<std::string> grid(kHeight, std::string(kWidth, ' '));
+    for (const OperationBudget& budget : kBudgets) {
+        const std::vector<double>& series = times.at(budget.name);
+        for (std::size_t i = 0; i < sizes.size(); ++i) {
+            const double x = (std::log10(static_cast<double>(sizes[i])) - sizeLow) / (sizeHigh - sizeLow);
+            const double y = (std::log10(std::max(series[i], 0.01)) - logLow) / (logHigh - logLow);
+            const int column = std::min(kWidth - 1, static_cast<int>(x * (kWidth - 1) + 0.5));
+            const int row = std::min(kHeight - 1, static_cast<int>(y * (kHeight - 1) + 0.5));
+            char& cell = grid[kHeight - 1 - row][column];
+            cell = cell == ' ' || cell == budget.symbol ? budget.symbol : '*';
+        }
+    }
+
+    out << "\nTime (ms, log scale) over library size (books, log scale)\n";
+    for (int row = 0; row < kHeight; ++row) {
+        const double ms = std::pow(10.0, logHigh - (logHigh - logLow) * row / (kHeight - 1));
+        out << std::setw(10) << std::setprecision(3) << ms << " |" << grid[row] << "\n";
+    }
+    out << std::string(11, ' ') << "+" << std::string(kWidth, '-') << "\n"
+        << std::string(12, ' ') << sizes.front()
+        << std::string(kWidth - 2 * std::to_string(sizes.front()).size(), ' ')
+        << sizes.back() << "\n  ";
+    for (const OperationBudget& budget : kBudgets) {
+        out << budget.symbol << " " << budget.name << "  ";
+    }
+    out << "(* overlap)\n";
+}
+
+/**
+ * @brief Write the raw timings as CSV (one row per size)
+ */
+void writeCsv(const std::string& path, const std::vector<std::size_t>& sizes,
+              const std::map<std::string, std::vector<double>>& times,
+              const std::vector<std::int64_t>& keyBytes) {
+    std::ofstream csv(path);
+    csv << "books";
+    for (const OperationBudget& budget : kBudgets) {
+        csv << "," << budget.name << "_ms";
+    }
+    csv << ",sort_key_bytes\n";
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        csv << sizes[i];
+        for (const OperationBudget& budget : kBudgets) {
+            csv << "," << times.at(budget.name)[i];
+        }
+        csv << "," << keyBytes[i] << "\n";
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Run the harness
+ * @return 0 if every operation stays within budget, 1 if not, 2 on errors
+ */
+int main(int argc, char* argv[]) {
+    HarnessOptions options;
+    try {
+        options = parseOptions(argc, argv);
+        MemoryAccounting::global().setBudgets(options.memoryBudget);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    std::vector<std::size_t> sizes;
+    for (double size = static_cast<double>(options.minBooks);
+         size <= static_cast<double>(options.maxBooks) * 1.0001; size *= options.factor) {
+        sizes.push_back(static_cast<std::size_t>(size));
+    }
+
+    std::map<std::string, std::vector<double>> times;
+    std::vector<std::int64_t> keyBytes;
+    std::string memoryReport;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(10) << "books";
+    for (const OperationBudget& budget : kBudgets) {
+        std::cout << std::setw(11) << budget.name;
+    }
+    std::cout << std::setw(11) << "keys MB" << "\n";
+
+    for (std::size_t size : sizes) {
+        std::map<std::string, double> measured;
+        std::int64_t sizeKeyBytes = 0;
+        try {
+            measured = measureSize(size, options, memoryReport, sizeKeyBytes);
+        } catch (const std::exception& e) {
+            std::cerr << "Size " << size << " failed: " << e.what() << "\n";
+            return 2;
+        }
+        std::cout << std::setw(10) << size;
+        for (const OperationBudget& budget : kBudgets) {
+            times[budget.name].push_back(measured[budget.name]);
+            std::cout << std::setw(11) << measured[budget.name];
+        }
+        keyBytes.push_back(sizeKeyBytes);
+        std::cout << std::setw(11) << sizeKeyBytes / (1024.0 * 1024.0) << std::endl;
+    }
+
+    plotCurves(std::cout, sizes, times);
+    std::cout << "\nMemory with " << sizes.back() << " books loaded\n" << memoryReport;
+    if (!options.csvPath.empty()) {
+        writeCsv(options.csvPath, sizes, times, keyBytes);
+    }
+
+    bool withinBudget = true;
+    std::cout << "\nGrowth exponents (1.00 = linear)\n";
+    for (const OperationBudget& budget : kBudgets) {
+        const std::vector<double>& series = times[budget.name];
+        double exponent = 0;
+        std::cout << "  " << std::left << std::setw(8) << budget.name << std::right;
+        if (!fitExponent(sizes, series, exponent)) {
+            std::cout << "  below noise floor\n";
+            continue;
+        }
+        const bool ok = exponent <= budget.maxExponent;
+        withinBudget = withinBudget && ok;
+        std::cout << std::setw(6) << exponent << " (budget " << budget.maxExponent << ") "
+                  << (ok ? "ok" : "OVER BUDGET");
+        if (series.back() > kInteractiveMs) {
+            std::cout << ", " << series.back() << " ms at " << sizes.back() << " books";
+        }
+        std::cout << "\n";
+    }
+    return withinBudget ? 0 : 1;
+}